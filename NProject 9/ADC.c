@@ -13,6 +13,8 @@
 #include  "ports.h"
 #include "macros.h"
 #include "globals.h"
+#include "quant.h"
+#include "profile.h"
 
 
 
@@ -24,6 +26,8 @@ unsigned int ADC_Left_Det  = 0;
 unsigned char ADC_Channel  = 0;
 unsigned int DAC_data = 0;
 
+volatile quant_t ADC_Thumb_Q;   // Thumbwheel zones for the menus (quant.c)
+
 
 //conversions
 char adc_char[4];
@@ -113,6 +117,8 @@ void Init_ADC(void){
 //----------------------------------------------------------------------------
 #pragma vector = ADC_VECTOR
 __interrupt void ADC_ISR(void) {
+    PROF_ENTER();
+
     switch (__even_in_range(ADCIV, ADCIV_ADCIFG)) {
         case ADCIV_NONE:
             break;
@@ -133,6 +139,7 @@ __interrupt void ADC_ISR(void) {
             switch (ADC_Channel++) {
                 case 0x00:  // Just converted A5 — Thumb Wheel
                     ADC_Thumb = ADCMEM0;
+                    Quant_Feed(&ADC_Thumb_Q, ADC_Thumb);
                     ADCMCTL0 &= ~ADCINCH_5;  // Disable A5
                     ADCMCTL0 |=  ADCINCH_3;  // Next: A3
                     break;
@@ -164,6 +171,8 @@ __interrupt void ADC_ISR(void) {
         default:
             break;
     }
+
+    PROF_EXIT(PROF_ADC);
 }
 
 
@@ -0,0 +1,95 @@
+//==============================================================================
+// File:        baud.h
+// Description: eUSCI_A UART baud-rate registers, computed at compile time.
+//
+//              The user's guide (SLAU445) procedure, in integer arithmetic:
+//                N = BRCLK / baud
+//                N >= 16:  UCOS16 = 1, UCBRx = INT(N / 16),
+//                          UCBRFx = INT(frac(N / 16) * 16)
+//                N <  16:  UCOS16 = 0, UCBRx = INT(N), UCBRFx = 0
+//                UCBRSx = "UCBRSx Settings for Fractional Portion of N"
+//                         table, looked up with frac(N) to 4 places
+//              No casts or sizeof, so everything here works in #if as well
+//              as in code: BAUD_BRW / BAUD_MCTLW go into UCAxBRW /
+//              UCAxMCTLW, BAUD_OK stops the build on a bad clock / baud pair.
+//
+//              BAUD_ERR_PPM is the average bit-time error: the BRCLK cycles
+//              a bit really gets (UCBRx, UCBRFx, plus UCBRSx's ones spread
+//              over 8 bits) against N.  The modulation's bit-to-bit jitter
+//              comes on top; the user's guide tables list it per setting.
+//              Its table of recommended settings came from a search and
+//              differs from the lookup in a few cells (8 MHz / 9600: UCBRSx
+//              0x49 there, 0x25 here -- both three ones, same bit rate).
+//
+//              project 9 part 2 has the same baud.h -- change both together.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef BAUD_H_
+#define BAUD_H_
+
+// UART clock: SMCLK = MCLK (DIVS__1 in Init_Clocks).  MCLK_FREQ_MHZ is in
+// macros.h; include it first.
+#ifndef BAUD_BRCLK_HZ
+#define BAUD_BRCLK_HZ           (MCLK_FREQ_MHZ * 1000000UL)
+#endif
+
+#define BAUD_ERR_MAX_PPM        (20000UL)   // 2 %: half of a typical UART's margin
+
+//------------------------------------------------------------------------------
+// Register fields
+//------------------------------------------------------------------------------
+#define BAUD_OS16(clk, baud)    ((clk) >= 16UL * (baud) ? 1UL : 0UL)
+#define BAUD_BRW(clk, baud)     (BAUD_OS16(clk, baud) ? (clk) / (16UL * (baud)) \
+                                                      : (clk) / (baud))
+#define BAUD_BRF(clk, baud)     (BAUD_OS16(clk, baud) ? ((clk) % (16UL * (baud))) / (baud) \
+                                                      : 0UL)
+#define BAUD_FRAC_E4(clk, baud) ((((clk) % (baud)) * 10000ULL) / (baud))
+#define BAUD_BRS(clk, baud)     BAUD_BRS_LOOKUP(BAUD_FRAC_E4(clk, baud))
+
+#define BAUD_MCTLW(clk, baud)   ((BAUD_BRS(clk, baud) << 8) | \
+                                 (BAUD_BRF(clk, baud) << 4) | BAUD_OS16(clk, baud))
+
+// frac(N) x 10^4 -> UCBRSx (largest entry not above it)
+#define BAUD_BRS_LOOKUP(f)                                                    \
+    ((f) >= 9288 ? 0xFEUL : (f) >= 9170 ? 0xFDUL : (f) >= 9004 ? 0xFBUL :     \
+     (f) >= 8751 ? 0xF7UL : (f) >= 8572 ? 0xEFUL : (f) >= 8464 ? 0xDFUL :     \
+     (f) >= 8333 ? 0xBFUL : (f) >= 8004 ? 0xEEUL : (f) >= 7861 ? 0xEDUL :     \
+     (f) >= 7503 ? 0xDDUL : (f) >= 7147 ? 0xBBUL : (f) >= 7001 ? 0xB7UL :     \
+     (f) >= 6667 ? 0xD6UL : (f) >= 6432 ? 0xB6UL : (f) >= 6254 ? 0xB5UL :     \
+     (f) >= 6003 ? 0xADUL : (f) >= 5715 ? 0x6BUL : (f) >= 5002 ? 0xAAUL :     \
+     (f) >= 4378 ? 0x55UL : (f) >= 4286 ? 0x53UL : (f) >= 4003 ? 0x92UL :     \
+     (f) >= 3753 ? 0x52UL : (f) >= 3575 ? 0x4AUL : (f) >= 3335 ? 0x49UL :     \
+     (f) >= 3000 ? 0x25UL : (f) >= 2503 ? 0x44UL : (f) >= 2224 ? 0x22UL :     \
+     (f) >= 2147 ? 0x21UL : (f) >= 1670 ? 0x11UL : (f) >= 1430 ? 0x20UL :     \
+     (f) >= 1252 ? 0x10UL : (f) >= 1001 ? 0x08UL : (f) >=  835 ? 0x04UL :     \
+     (f) >=  715 ? 0x02UL : (f) >=  529 ? 0x01UL : 0x00UL)
+
+//------------------------------------------------------------------------------
+// Error bound
+//------------------------------------------------------------------------------
+#define BAUD_POP8(x)            ((((x) >> 0) & 1UL) + (((x) >> 1) & 1UL) + \
+                                 (((x) >> 2) & 1UL) + (((x) >> 3) & 1UL) + \
+                                 (((x) >> 4) & 1UL) + (((x) >> 5) & 1UL) + \
+                                 (((x) >> 6) & 1UL) + (((x) >> 7) & 1UL))
+
+// BRCLK cycles per bit as programmed, x8 (UCBRSx adds one cycle per set bit)
+#define BAUD_CYC8(clk, baud)    (8ULL * (BAUD_OS16(clk, baud)                  \
+                                         ? 16UL * BAUD_BRW(clk, baud) + BAUD_BRF(clk, baud) \
+                                         : BAUD_BRW(clk, baud))               \
+                                 + BAUD_POP8(BAUD_BRS(clk, baud)))
+
+#define BAUD_ERR_PPM(clk, baud)                                               \
+    ((BAUD_CYC8(clk, baud) * (baud) >= 8ULL * (clk)                           \
+      ? BAUD_CYC8(clk, baud) * (baud) - 8ULL * (clk)                          \
+      : 8ULL * (clk) - BAUD_CYC8(clk, baud) * (baud)) * 1000000ULL / (8ULL * (clk)))
+
+// eUSCI_A needs BRCLK >= 3 x baud
+#define BAUD_OK(clk, baud)      ((clk) >= 3UL * (baud) && \
+                                 BAUD_ERR_PPM(clk, baud) <= BAUD_ERR_MAX_PPM)
+
+#endif /* BAUD_H_ */
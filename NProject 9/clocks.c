@@ -19,9 +19,14 @@
 #include  "macros.h"
 
 // MACROS========================================================================
-#define MCLK_FREQ_MHZ           (8) // MCLK = 8MHz
 #define CLEAR_REGISTER     (0X0000)
 
+// DCORSEL_3 / FLLN 243 below, and the TB0 divider (timers_interrupts.c), are
+// for 8 MHz.  MCLK_FREQ_MHZ (macros.h) only records that.
+#if MCLK_FREQ_MHZ != 8
+#error "MCLK_FREQ_MHZ must be 8: Init_Clocks and the timer dividers are set for 8 MHz"
+#endif
+
 void Init_Clocks(void);
 void Software_Trim(void);
 
@@ -0,0 +1,40 @@
+//==============================================================================
+// File:        fmt.h
+// Description: Fixed-width number formatting without division.
+//
+//              Each call writes straight into the caller's buffer
+//              (display_line[n] + column, a TX message template, ...) and
+//              returns the pointer just past the last character.  Nothing
+//              is NUL-terminated.
+//
+//              width is the number of cells written, including a '-' and
+//              the '.' of a fixed-point value.  A value wider than width
+//              keeps its low-order digits (the old "(v / 100) % 10" chains
+//              behaved the same way).  width 0 = as many cells as needed.
+//              pad is FMT_ZERO or FMT_SPACE for the cells left of the first
+//              significant digit.
+//
+//              project 9 part 2 has the same fmt.h -- change both together.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef FMT_H_
+#define FMT_H_
+
+#define FMT_ZERO            ('0')
+#define FMT_SPACE           (' ')
+
+char *Fmt_Dec(char *dst, unsigned int value, unsigned char width, char pad);
+char *Fmt_Sdec(char *dst, int value, unsigned char width, char pad);
+char *Fmt_Dec32(char *dst, unsigned long value, unsigned char width, char pad);
+char *Fmt_Hex(char *dst, unsigned int value, unsigned char width);
+
+// value is scaled by 10^frac: Fmt_Fixed(p, 1234, 1, 5, FMT_SPACE) -> "123.4"
+char *Fmt_Fixed(char *dst, unsigned int value, unsigned char frac,
+                unsigned char width, char pad);
+
+#endif /* FMT_H_ */
@@ -80,10 +80,7 @@ void LCD_iot_meassage_print(int nema_index);
 
 // Menu (menus.c)
 void Menu_Process(void);    // top-level dispatcher — call every main-loop tick
-void Main_Menu(void);       // 3-item scrolling main menu
-void Resistor_Menu(void);   // resistor colour-code sub-menu (10 items)
-void Shapes_Menu(void);     // shapes sub-menu — uses lcd_BIG_mid()
-void Song_Menu(void);       // fight-song scroll sub-menu — uses lcd_BIG_mid()
+                            // (engine and descriptor types: menu_engine.h)
 
 // Ports
 void Init_Ports(void);
@@ -59,6 +59,9 @@ extern unsigned int  IR_THRESHOLD;
 extern unsigned char cal_state;
 
 extern volatile unsigned int ir_cnt;
+extern unsigned int search_count;
+extern unsigned int search_fails;
+extern unsigned int search_max_ticks;
 
 extern volatile unsigned int display_timer;  // counts in 200ms ticks
 
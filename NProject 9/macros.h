@@ -54,6 +54,9 @@
 #define TB0IV_CCR2          (4)
 #define TB0IV_OVERFLOW      (14)
 
+// ISR profiler (profile.h) — uncomment to build it in; uses Timer B2
+//#define ISR_PROFILE
+
 // DAC
 #define DAC_Begin           (2725)
 #define DAC_Limit           (850)
@@ -98,7 +101,14 @@
 #define BLACK_LINE      ('B')
 #define LEFT            ('<')
 #define RIGHT           ('>')
-#define SEARCH_FWD      (4)    // tune this — ticks before switching spin di
+// Lost-line search (project6.c Line_Search), all times in 50ms ticks
+#define SEARCH_SWING    (2)     // first sweep length, each later one adds this
+#define SEARCH_SWINGS   (5)     // sweeps before switching to the spiral
+#define SEARCH_TIMEOUT  (160)   // 8 s lost -> stop
+#define SPIRAL_STEP     (100)   // inner wheel PWM added per tick of spiral
+#define SEARCH_IDLE     (0)     // searching: on the line
+#define SEARCH_ACTIVE   (1)     //            sweep / spiral running
+#define SEARCH_GAVE_UP  (2)     //            timed out, failure counted
 
 
 #define PERCENT_80      (45000)
@@ -109,6 +119,14 @@
 #define BAUD_9600       (2)
 #define BAUD_460800     (1)
 
+// System clock (Init_Clocks: MCLK = SMCLK = DCO); UART BRW / MCTLW are
+// derived from it in serial.c through baud.h.  Init_Clocks and the timer
+// dividers are still written for 8 MHz; clocks.c stops the build otherwise.
+#define MCLK_FREQ_MHZ       (8)
+#define UART_BAUD_9600      (9600UL)
+#define UART_BAUD_115200    (115200UL)
+#define UART_BAUD_460800    (460800UL)
+
 // IOT_EN alias (P3.7 is named IOT_RN in ports.h — same pin)
 #define IOT_EN              IOT_RN
 
@@ -145,38 +163,13 @@
 
 // ─── Homework 9: Menu System ──────────────────────────────────────────────────
 
-// Top-level menu state values
-#define MENU_SPLASH         (0)   // startup splash — wait for any button press
-#define MENU_MAIN           (1)   // 3-item main menu (Resistors / Shapes / Song)
-#define MENU_RESISTOR       (2)   // resistor colour-code sub-menu
-#define MENU_SHAPES         (3)   // shapes sub-menu (lcd_BIG_mid)
-#define MENU_SONG           (4)   // song scroll sub-menu (lcd_BIG_mid)
-
-// Main-menu item indices
-#define MAIN_RESISTORS      (0)
-#define MAIN_SHAPES         (1)
-#define MAIN_SONG           (2)
-#define NUM_MAIN_ITEMS      (3)
-
-// ADC dividers — 10-bit ADC range is 0–1023
-#define ADC_MAIN_DIV        (341)   // 1024/3  → 3 equal regions for main menu
-#define ADC_SUB_DIV         (102)   // 1024/10 → 10 equal regions for sub-menus
-
-// Sub-menu item counts
-#define NUM_RESISTORS       (10)
-#define NUM_SHAPES          (10)
-
 // Song-scroll constants
 #define SONG_DISP_LEN       (10)  // visible character width of the big LCD line
-#define LCD_LINE_BUF        (SONG_DISP_LEN + 1) // display_line column size (10 chars + null)
-#define ADC_SONG_SHIFT      (7)   // right-shift maps 10-bit ADC → 8 zones (0–7)
+#define SONG_ZONES          (8)   // thumbwheel zones for the song ratchet (0–7)
 #define SONG_CHARS_PER_ZONE (5)   // song characters advanced per CCW zone crossing
 #define SONG_ALT_RESET      (0)   // initial value of the Line-1/3 alternating flag
 #define SONG_START          (0)   // starting character index into song_text[]
 
-// Sentinel value — wider than any valid item index (0–9), forces a redraw
-#define INVALID_ITEM        (0xFFFFu)
-
 // display_line[] index aliases (lcd_4line mode)
 #define MENU_LINE1          (0)
 #define MENU_LINE2          (1)
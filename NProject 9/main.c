@@ -30,6 +30,7 @@
 #include  "ports.h"
 #include  "macros.h"
 #include  "globals.h"
+#include  "profile.h"
 
 // Function prototypes (this file)
 void main(void);
@@ -78,6 +79,7 @@ void main(void)
     Init_Conditions();              // Zero buffers, enable global interrupts
     Init_Timer_B0();                // 50 ms tick, switch debounce
     Init_Timer_B3();                // PWM for motors and LCD backlight
+    Prof_Init();                    // TB2 cycle counter (ISR_PROFILE only)
     Init_LCD();                     // SPI + LCD controller init (defaults 4-line)
     Init_ADC();                     // 12-bit ADC: thumb (A5), IR sensors (A2/A3)
     Init_DAC();                     // SAC3 DAC for LED fade (TB0 overflow ISR)
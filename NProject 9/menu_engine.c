@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------------
+// File:    menu_engine.c
+// Author:  Noah Cartwright
+// Date:    April 7, 2026
+// Course:  ECE 306 — Introduction to Embedded Systems
+//
+// Description:
+//   Generic thumbwheel menu engine (see menu_engine.h).  Entering a menu
+//   sets ADC_Thumb_Q's zones to its item count; after that nothing is
+//   drawn unless the quantizer reports an index change.  Lines are
+//   written through Menu_Engine_Line, which only flags a refresh when the
+//   text actually differs from display_line[], so the fixed head/foot lines
+//   cost nothing after entry.
+//
+// Globals Read:    ADC_Thumb_Q, sw1_action_pending, sw2_action_pending
+// Globals Written: display_line[][], display_changed, update_display,
+//                  sw1_action_pending, sw2_action_pending
+//------------------------------------------------------------------------------
+
+#include  "msp430.h"
+#include  "functions.h"
+#include  "LCD.h"
+#include  "ports.h"
+#include  "macros.h"
+#include  "globals.h"
+#include  "quant.h"
+#include  "menu_engine.h"
+
+#define MENU_COLS           (10)
+#define MENU_MARK           ('>')
+
+// ─── Engine state — the only RAM the menus use ───────────────────────────────
+static const menu_t  *menu_cur   = NULL;
+static unsigned char  menu_index = 0;
+
+//------------------------------------------------------------------------------
+// Function: menu_item_line
+// Description: Writes one item label to a line, with a marker character in
+//              column 0 for MENU_LIST, or a blank line for an index off
+//              either end of the table.
+// Parameters:  line  — display_line[] index
+//              menu  — current menu
+//              index — item index; may be -1 or count
+//              mark  — '\0' for none, else ' ' or MENU_MARK
+// Returns:     None
+//------------------------------------------------------------------------------
+static void menu_item_line(unsigned char line, const menu_t *menu,
+                           int index, char mark)
+{
+    char         buf[MENU_COLS + 1];
+    const char  *src = "";
+    unsigned char i  = 0;
+
+    if (index >= 0 && index < (int)menu->count)
+    {
+        src = menu->items[index].label;
+        if (mark != '\0')
+        {
+            buf[i++] = mark;
+        }
+    }
+    while (i < MENU_COLS && *src != '\0')
+    {
+        buf[i++] = *src++;
+    }
+    buf[i] = '\0';
+    Menu_Engine_Line(line, buf);
+}
+
+//------------------------------------------------------------------------------
+// Function: menu_draw
+// Description: Lays out the selected item of a MENU_LIST / MENU_DETAIL /
+//              MENU_BIG menu.
+// Parameters:  None
+// Returns:     None
+//------------------------------------------------------------------------------
+static void menu_draw(void)
+{
+    const menu_t      *m   = menu_cur;
+    const menu_item_t *sel = &m->items[menu_index];
+    int                idx = (int)menu_index;
+
+    switch (m->layout)
+    {
+        case MENU_LIST:
+            menu_item_line(MENU_LINE1, m, idx - 1, ' ');
+            menu_item_line(MENU_LINE2, m, idx,     MENU_MARK);
+            menu_item_line(MENU_LINE3, m, idx + 1, ' ');
+            Menu_Engine_Line(MENU_LINE4, m->head);
+            break;
+
+        case MENU_DETAIL:
+            Menu_Engine_Line(MENU_LINE1, m->head);
+            Menu_Engine_Line(MENU_LINE2, sel->label);
+            Menu_Engine_Line(MENU_LINE3, m->foot);
+            Menu_Engine_Line(MENU_LINE4, sel->detail);
+            break;
+
+        case MENU_BIG:
+        default:
+            menu_item_line(BIG_TOP, m, idx - 1, '\0');
+            menu_item_line(BIG_MID, m, idx,     '\0');
+            menu_item_line(BIG_BOT, m, idx + 1, '\0');
+            break;
+    }
+}
+
+//==============================================================================
+// Function: Menu_Engine_Line
+// Description:
+//   Copies text into display_line[line], padded or cut to 10 characters,
+//   and flags an immediate refresh only if a character changed.  NULL
+//   text writes a blank line.
+// Parameters:  line — display_line[] index (0–3)
+//              text — NUL-terminated text, or NULL
+// Returns:     None
+// Globals Modified: display_line[][], display_changed, update_display
+//==============================================================================
+void Menu_Engine_Line(unsigned char line, const char *text)
+{
+    char          *dst = display_line[line];
+    unsigned char  i;
+    char           c;
+
+    if (text == NULL)
+    {
+        text = "";
+    }
+    for (i = 0; i < MENU_COLS; i++)
+    {
+        c = (*text != '\0') ? *text++ : ' ';
+        if (dst[i] != c)
+        {
+            dst[i]          = c;
+            display_changed = TRUE;
+            update_display  = TRUE;
+        }
+    }
+    dst[MENU_COLS] = '\0';
+}
+
+//==============================================================================
+// Function: Menu_Engine_Start
+// Description:
+//   Enters a menu: selects its LCD layout, takes the thumbwheel's current
+//   zone as the selection and draws it (MENU_CUSTOM: runs enter()).
+// Parameters:  menu — descriptor to enter
+// Returns:     None
+// Globals Modified: display_line[][], display_changed, update_display
+//==============================================================================
+void Menu_Engine_Start(const menu_t *menu)
+{
+    Quant_Config(&ADC_Thumb_Q, menu->count, NULL,
+                 MENU_THUMB_HYST, MENU_THUMB_FILTER);
+    menu_cur   = menu;
+    menu_index = Quant_Index(&ADC_Thumb_Q);
+
+    if (menu->layout == MENU_BIG || menu->layout == MENU_CUSTOM)
+    {
+        lcd_BIG_mid();
+    }
+    else
+    {
+        lcd_4line();
+    }
+
+    if (menu->layout == MENU_CUSTOM)
+    {
+        if (menu->enter != NULL)
+        {
+            menu->enter();
+        }
+    }
+    else
+    {
+        menu_draw();
+    }
+}
+
+//==============================================================================
+// Function: Menu_Engine_Process
+// Description:
+//   Called every main-loop pass once a menu has been started.  Redraws (or
+//   calls update()) only on a thumbwheel index event, then handles SW1
+//   (action, then child) and SW2 (parent).
+// Parameters:  None
+// Returns:     None
+// Globals Modified: sw1_action_pending, sw2_action_pending,
+//                   display_line[][], display_changed, update_display
+//==============================================================================
+void Menu_Engine_Process(void)
+{
+    const menu_t      *m = menu_cur;
+    const menu_item_t *sel;
+    unsigned char      index;
+    unsigned char      from;
+
+    if (m == NULL)
+    {
+        return;
+    }
+
+    if (Quant_Event(&ADC_Thumb_Q, &from, &index))
+    {
+        menu_index = index;
+        if (m->layout == MENU_CUSTOM)
+        {
+            if (m->update != NULL)
+            {
+                m->update(from, index);
+            }
+        }
+        else
+        {
+            menu_draw();
+        }
+    }
+
+    if (sw1_action_pending)
+    {
+        sw1_action_pending = CLEAR_FLAG;
+        if (m->layout != MENU_CUSTOM)
+        {
+            sel = &m->items[menu_index];
+            if (sel->action != NULL)
+            {
+                sel->action();
+            }
+            if (sel->child != NULL)
+            {
+                Menu_Engine_Start(sel->child);
+            }
+        }
+    }
+
+    if (sw2_action_pending)
+    {
+        sw2_action_pending = CLEAR_FLAG;
+        if (menu_cur->parent != NULL)       // SW1 may have just moved down
+        {
+            Menu_Engine_Start(menu_cur->parent);
+        }
+    }
+}
+
+//==============================================================================
+// Function: Menu_Engine_Current
+// Returns: The menu being shown, or NULL before the first Menu_Engine_Start
+//==============================================================================
+const menu_t *Menu_Engine_Current(void)
+{
+    return menu_cur;
+}
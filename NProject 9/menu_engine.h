@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+// File:    menu_engine.h
+// Author:  Noah Cartwright
+// Date:    April 7, 2026
+// Course:  ECE 306 — Introduction to Embedded Systems
+//
+// Description:
+//   Table-driven thumbwheel menus.  A menu is a const menu_t descriptor
+//   (placed in FRAM by the compiler) holding its item table, LCD layout,
+//   parent menu and optional hooks.  The engine keeps only the current menu
+//   and the selected index in RAM, so adding a menu is adding a descriptor —
+//   no new RAM and no new code.
+//
+//   LAYOUTS
+//   ───────
+//   MENU_LIST   (lcd_4line)   Line 1 previous item, Line 2 '>' + selected,
+//                             Line 3 next item, Line 4 head text
+//   MENU_DETAIL (lcd_4line)   Line 1 head, Line 2 selected label,
+//                             Line 3 foot, Line 4 selected detail
+//   MENU_BIG    (lcd_BIG_mid) previous / selected (large) / next
+//   MENU_CUSTOM (lcd_BIG_mid) enter() on entry, update(from, to) on each
+//                             thumbwheel zone event; items unused
+//
+//   SW1 runs the selected item's action, then enters its child (if any).
+//   SW2 returns to the parent menu (ignored at the top).
+//------------------------------------------------------------------------------
+
+#ifndef MENU_ENGINE_H_
+#define MENU_ENGINE_H_
+
+// Layouts
+#define MENU_LIST           (0)
+#define MENU_DETAIL         (1)
+#define MENU_BIG            (2)
+#define MENU_CUSTOM         (3)
+
+// Thumbwheel: one equal zone per item (count <= QUANT_MAX_ZONES), read
+// through ADC_Thumb_Q (quant.h) so a wheel resting on a boundary does not
+// flicker between items.
+#define MENU_THUMB_HYST     (12)    // ADC counts each side of a boundary
+#define MENU_THUMB_FILTER   (2)     // IIR 1/4 per 64-sample block
+
+typedef struct menu menu_t;
+
+typedef struct
+{
+    const char    *label;               // Item text (padded to 10 by the engine)
+    const char    *detail;              // MENU_DETAIL Line 4, else NULL
+    const menu_t  *child;               // SW1 enters this menu, or NULL
+    void         (*action)(void);       // SW1 runs this first, or NULL
+} menu_item_t;
+
+struct menu
+{
+    const menu_item_t *items;
+    unsigned char      count;           // Items; zones for MENU_CUSTOM
+    unsigned char      layout;          // MENU_LIST ... MENU_CUSTOM
+    const char        *head;            // See LAYOUTS above; NULL = blank
+    const char        *foot;
+    const menu_t      *parent;          // SW2 goes here, NULL = top level
+    void             (*enter)(void);                        // MENU_CUSTOM
+    void             (*update)(unsigned char from, unsigned char to);
+};
+
+void           Menu_Engine_Start(const menu_t *menu);
+void           Menu_Engine_Process(void);
+const menu_t  *Menu_Engine_Current(void);  // NULL before the first Start
+void           Menu_Engine_Line(unsigned char line, const char *text);
+
+#endif /* MENU_ENGINE_H_ */
@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------------
+// File:    profile.c
+// Author:  Noah Cartwright
+// Date:    April 14, 2026
+// Course:  ECE 306 — Introduction to Embedded Systems
+//
+// Description:
+//   ISR profiler (see profile.h).  The ISR side only adds into prof_stat[];
+//   the report is built in the main loop one line at a time and sent with
+//   Transmit_UCA1_String whenever the previous line has gone out, e.g.
+//       ADC   n=1234567
+//         cy 38/52/310
+//       TB0.0 n=4012
+//         cy 61/64/88
+//         lat 16/48
+//------------------------------------------------------------------------------
+
+#include  "msp430.h"
+#include  "functions.h"
+#include  "ports.h"
+#include  "macros.h"
+#include  "globals.h"
+#include  "fmt.h"
+#include  "profile.h"
+
+#define PROF_LINE_LEN       (32)    // Matches uca1_tx_buf
+#define PROF_PART_NAME      (0)     // Report lines per vector
+#define PROF_PART_CYCLES    (1)
+#define PROF_PART_LATENCY   (2)
+#define PROF_PARTS          (3)
+#define PROF_IDLE           (0xFF)
+
+static char          prof_line[PROF_LINE_LEN];
+static unsigned char prof_rep_id   = PROF_IDLE;     // Vector being reported
+static unsigned char prof_rep_part = 0;
+static char          prof_rep_reset = FALSE;
+
+#ifdef ISR_PROFILE
+
+typedef struct
+{
+    unsigned long count;
+    unsigned long total;            // Cycles
+    unsigned int  min;
+    unsigned int  max;
+    unsigned long lat_count;
+    unsigned long lat_total;        // Cycles
+    unsigned int  lat_max;
+} prof_stat_t;
+
+static const char *const prof_name[PROF_COUNT] = {
+    "ADC  ", "UCA0 ", "UCA1 ", "TB0.0", "TB0.1"
+};
+
+static volatile prof_stat_t prof_stat[PROF_COUNT];
+static unsigned int         prof_overhead = 0;      // Cycles of the two reads
+
+//------------------------------------------------------------------------------
+// Function: prof_clear
+// Description: Zeroes every vector's statistics (min starts at its ceiling).
+//------------------------------------------------------------------------------
+static void prof_clear(void)
+{
+    unsigned char i;
+
+    for (i = 0; i < PROF_COUNT; i++)
+    {
+        prof_stat[i].count     = 0;
+        prof_stat[i].total     = 0;
+        prof_stat[i].min       = 0xFFFFu;
+        prof_stat[i].max       = 0;
+        prof_stat[i].lat_count = 0;
+        prof_stat[i].lat_total = 0;
+        prof_stat[i].lat_max   = 0;
+    }
+}
+
+//==============================================================================
+// Function: Prof_Init
+// Description:
+//   Starts Timer B2 free-running at SMCLK/1 and measures what an empty
+//   PROF_ENTER / PROF_EXIT pair reads, so it can be taken off every sample.
+// Globals Modified: TB2CTL, prof_stat[], prof_overhead
+//==============================================================================
+void Prof_Init(void)
+{
+    unsigned int t0;
+
+    TB2CTL  = TBSSEL__SMCLK;        // SMCLK, no dividers: 1 count = 1 cycle
+    TB2EX0  = TBIDEX__1;
+    TB2CTL |= TBCLR;
+    TB2CTL |= MC__CONTINOUS;
+
+    t0            = PROF_NOW;
+    prof_overhead = (unsigned int)(PROF_NOW - t0);
+    prof_clear();
+}
+
+//==============================================================================
+// Function: Prof_Record
+// Description: ISR exit — adds one execution time to vector id.
+//==============================================================================
+void Prof_Record(unsigned char id, unsigned int t0)
+{
+    volatile prof_stat_t *s  = &prof_stat[id];
+    unsigned int          dt = (unsigned int)(PROF_NOW - t0) - prof_overhead;
+
+    s->count++;
+    s->total += dt;
+    if (dt < s->min)
+    {
+        s->min = dt;
+    }
+    if (dt > s->max)
+    {
+        s->max = dt;
+    }
+}
+
+//==============================================================================
+// Function: Prof_Latency
+// Description: ISR entry — TB0 counts since the compare that raised it.
+//==============================================================================
+void Prof_Latency(unsigned char id, unsigned int tb0_counts)
+{
+    volatile prof_stat_t *s   = &prof_stat[id];
+    unsigned int          lat = tb0_counts * PROF_TB0_CYCLES;
+
+    s->lat_count++;
+    s->lat_total += lat;
+    if (lat > s->lat_max)
+    {
+        s->lat_max = lat;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Function: prof_build
+// Description: Formats report line prof_rep_part of vector prof_rep_id from
+//              a copy taken with interrupts off (the ISRs write 32-bit sums).
+// Returns:     TRUE if there is a line to send
+//------------------------------------------------------------------------------
+static char prof_build(void)
+{
+    prof_stat_t  s;
+    char        *p = prof_line;
+
+    __disable_interrupt();
+    s = prof_stat[prof_rep_id];
+    __enable_interrupt();
+
+    switch (prof_rep_part)
+    {
+        case PROF_PART_NAME:
+            for (p = prof_line; p < prof_line + 5; p++)
+            {
+                *p = prof_name[prof_rep_id][p - prof_line];
+            }
+            *p++ = ' ';
+            *p++ = 'n';
+            *p++ = '=';
+            p = Fmt_Dec32(p, s.count, 0, FMT_SPACE);
+            break;
+
+        case PROF_PART_CYCLES:
+            if (s.count == 0)
+            {
+                return FALSE;
+            }
+            *p++ = ' ';  *p++ = ' ';  *p++ = 'c';  *p++ = 'y';  *p++ = ' ';
+            p = Fmt_Dec(p, s.min, 0, FMT_SPACE);
+            *p++ = '/';
+            p = Fmt_Dec32(p, s.total / s.count, 0, FMT_SPACE);
+            *p++ = '/';
+            p = Fmt_Dec(p, s.max, 0, FMT_SPACE);
+            break;
+
+        case PROF_PART_LATENCY:
+        default:
+            if (s.lat_count == 0)
+            {
+                return FALSE;
+            }
+            *p++ = ' ';  *p++ = ' ';  *p++ = 'l';  *p++ = 'a';  *p++ = 't';
+            *p++ = ' ';
+            p = Fmt_Dec32(p, s.lat_total / s.lat_count, 0, FMT_SPACE);
+            *p++ = '/';
+            p = Fmt_Dec(p, s.lat_max, 0, FMT_SPACE);
+            break;
+    }
+    *p++ = '\r';
+    *p++ = '\n';
+    *p   = '\0';
+    return TRUE;
+}
+
+#endif /* ISR_PROFILE */
+
+//==============================================================================
+// Function: Prof_Report_Start
+// Description: ^P / ^PR — queue a report of every vector; reset clears the
+//              statistics once it has been sent.
+//==============================================================================
+void Prof_Report_Start(char reset)
+{
+    prof_rep_id    = 0;
+    prof_rep_part  = PROF_PART_NAME;
+    prof_rep_reset = reset;
+}
+
+//==============================================================================
+// Function: Prof_Process
+// Description:
+//   Main loop — sends the next report line once UCA1 is free.  Lines with
+//   nothing to say (no samples, no latency source) are skipped.
+// Globals Read: tx1_busy
+//==============================================================================
+void Prof_Process(void)
+{
+    if (prof_rep_id == PROF_IDLE || tx1_busy)
+    {
+        return;
+    }
+
+#ifdef ISR_PROFILE
+    while (prof_rep_id < PROF_COUNT)
+    {
+        char ready = prof_build();
+
+        if (++prof_rep_part >= PROF_PARTS)
+        {
+            prof_rep_part = PROF_PART_NAME;
+            prof_rep_id++;
+        }
+        if (ready)
+        {
+            Transmit_UCA1_String(prof_line);
+            return;
+        }
+    }
+    if (prof_rep_reset)
+    {
+        __disable_interrupt();
+        prof_clear();
+        __enable_interrupt();
+    }
+#else
+    (void)prof_rep_part;
+    (void)prof_rep_reset;
+    Transmit_UCA1_String("ISR profile off\r\n");
+#endif
+    prof_rep_id = PROF_IDLE;
+}
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+// File:    profile.h
+// Author:  Noah Cartwright
+// Date:    April 14, 2026
+// Course:  ECE 306 — Introduction to Embedded Systems
+//
+// Description:
+//   Opt-in ISR execution-time profiler.  Define ISR_PROFILE (macros.h, or
+//   -DISR_PROFILE) to build it in; without it PROF_ENTER / PROF_EXIT /
+//   PROF_LATENCY_TB0 expand to nothing and the ISRs are unchanged.
+//
+//   Timestamps come from Timer B2 running free on SMCLK (= MCLK, 8 MHz), so
+//   one count is one CPU cycle; it wraps every 8.2 ms, far longer than any
+//   ISR.  Each profiled ISR does
+//       PROF_ENTER();                  first statement after declarations
+//       ...
+//       PROF_EXIT(PROF_xxx);           last statement
+//   A time is the cycles between the two, which leaves out the 6-cycle
+//   interrupt entry, the compiler's register save/restore and RETI.
+//
+//   Latency (flag set → first ISR statement) can only be measured where the
+//   hardware says when the flag was set: the Timer B0 compare vectors,
+//   from TB0R − TB0CCRn.  TB0 counts SMCLK/16, so latency has 16-cycle
+//   resolution.
+//
+//   ^P over UCA1 prints count, min/avg/max cycles and latency per vector;
+//   ^PR prints and then clears them.
+//------------------------------------------------------------------------------
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+// Profiled vectors
+#define PROF_ADC            (0)     // ADC_ISR
+#define PROF_UCA0           (1)     // eUSCI_A0_ISR (IOT)
+#define PROF_UCA1           (2)     // eUSCI_A1_ISR (PC)
+#define PROF_TB0_CCR0       (3)     // Timer0_B0_ISR (50 ms tick)
+#define PROF_TB0_CCR12      (4)     // TIMER0_B1_ISR (debounce, DAC ramp)
+#define PROF_COUNT          (5)
+
+#define PROF_TB0_CYCLES     (16)    // MCLK cycles per TB0 count (ID__2 × 8)
+
+#ifdef ISR_PROFILE
+
+#define PROF_NOW                    (TB2R)
+#define PROF_ENTER()                unsigned int prof_t0 = PROF_NOW
+#define PROF_EXIT(id)               Prof_Record((id), prof_t0)
+#define PROF_LATENCY_TB0(id, ccr)   Prof_Latency((id), (unsigned int)(TB0R - (ccr)))
+
+void Prof_Init(void);
+void Prof_Record(unsigned char id, unsigned int t0);
+void Prof_Latency(unsigned char id, unsigned int tb0_counts);
+
+#else
+
+#define PROF_ENTER()
+#define PROF_EXIT(id)
+#define PROF_LATENCY_TB0(id, ccr)
+#define Prof_Init()
+
+#endif /* ISR_PROFILE */
+
+// Main loop — always built (reports "off" when ISR_PROFILE is not defined)
+void Prof_Report_Start(char reset);
+void Prof_Process(void);
+
+#endif /* PROFILE_H_ */
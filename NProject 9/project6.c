@@ -13,6 +13,7 @@
 #include "ports.h"
 #include "macros.h"
 #include "globals.h"
+#include "fmt.h"
 
 char display_line[4][11];
 
@@ -24,10 +25,123 @@ unsigned int WHITE_CAL_R = 290;
 unsigned int IR_THRESHOLD = 100;
 unsigned char cal_state = 0;
 
-// ir_cnt: incremented in bang-bang when both sensors see white (lost line)
+// ir_cnt: 50ms ticks spent in WHITE_SEARCH (counted in Timer0_B0_ISR)
 volatile unsigned int ir_cnt = 0;
 volatile unsigned int display_timer = 0;
 
+// Lost-line search bookkeeping (see Line_Search)
+unsigned int search_count = 0;       // times the line was found again
+unsigned int search_fails = 0;       // times the search ran out of time
+unsigned int search_max_ticks = 0;   // longest successful search, 50ms ticks
+static char last_side = RIGHT;       // side of the car the line was last seen on
+static char searching = SEARCH_IDLE;
+static unsigned int search_start = 0;
+
+//------------------------------------------------------------------------------
+// Line_Found
+// Called by every bang-bang branch that has a reading. side is where the
+// line is relative to the car. Closes out a search if one was running.
+//------------------------------------------------------------------------------
+static void Line_Found(char side)
+{
+    unsigned int took;
+
+    last_side = side;
+    if (searching == SEARCH_ACTIVE)
+    {
+        took = Time_Sequence - search_start;
+        search_count++;
+        if (took > search_max_ticks)
+        {
+            search_max_ticks = took;
+        }
+    }
+    searching = SEARCH_IDLE;
+}
+
+//------------------------------------------------------------------------------
+// Line_Search
+// Both sensors white. How long we've been lost (50ms ticks since
+// search_start) picks what to do:
+//   sweep  - SEARCH_SWINGS pivots, alternating sides, each one SEARCH_SWING
+//            ticks longer than the last. First swing goes toward last_side
+//            so a line we just slid off is usually found in under 100ms.
+//   spiral - outer wheel at SLOW, inner wheel opening up by SPIRAL_STEP per
+//            tick, so the car circles outward over new floor
+//   give up after SEARCH_TIMEOUT and sit still instead of wandering off
+//------------------------------------------------------------------------------
+static void Line_Search(void)
+{
+    unsigned int lost;
+    unsigned int swing = 0;
+    unsigned int len = SEARCH_SWING;
+    unsigned int inner;
+    char side;
+
+    if (searching == SEARCH_IDLE)
+    {
+        searching = SEARCH_ACTIVE;
+        search_start = Time_Sequence;
+    }
+    if (searching == SEARCH_GAVE_UP)
+    {
+        return;                 // motors already reset by caller
+    }
+    lost = Time_Sequence - search_start;
+
+    if (lost >= SEARCH_TIMEOUT)
+    {
+        search_fails++;         // once: the state stops us coming back here
+        searching = SEARCH_GAVE_UP;
+        return;
+    }
+
+    // work out which swing we are in
+    while (swing < SEARCH_SWINGS && lost >= len)
+    {
+        lost -= len;
+        swing++;
+        len += SEARCH_SWING;
+    }
+
+    // even swings go toward last_side, odd ones back the other way
+    side = last_side;
+    if (swing & 1)
+    {
+        side = (last_side == LEFT) ? RIGHT : LEFT;
+    }
+
+    if (swing < SEARCH_SWINGS)
+    {
+        if (side == LEFT)
+        {
+            pivot_left_pwm(SLOW);
+        }
+        else
+        {
+            pivot_right_pwm(SLOW);
+        }
+        return;
+    }
+
+    // spiral - lost now counts ticks since the sweep finished
+    inner = SLOW;
+    if (lost < SLOW / SPIRAL_STEP)
+    {
+        inner = lost * SPIRAL_STEP;
+    }
+    if (last_side == LEFT)
+    {
+        LEFT_FORWARD_SPEED = inner;
+        RIGHT_FORWARD_SPEED = SLOW;
+    }
+    else
+    {
+        LEFT_FORWARD_SPEED = SLOW;
+        RIGHT_FORWARD_SPEED = inner;
+    }
+}
+
 //------------------------------------------------------------------------------
 // Bang_Bang_Control
 // Called from Circle_Navigation() when in CIRCLING state.
@@ -61,7 +175,7 @@ void Bang_Bang_Control(void)
     if (left_black && right_black)
     {
         motors_forward();
-        ir_cnt = 0; // not lost anymore
+        Line_Found(last_side); // not lost anymore
     }
 
     // left sees black, right sees white
@@ -69,7 +183,7 @@ void Bang_Bang_Control(void)
     else if (left_black && right_white)
     {
         pivot_left_pwm(SLOW);
-        ir_cnt = 0;
+        Line_Found(LEFT);
     }
 
     // opposite of above
@@ -78,23 +192,14 @@ void Bang_Bang_Control(void)
     else if (left_white && right_black)
     {
         pivot_right_pwm(SLOW);
-        ir_cnt = 0;
+        Line_Found(RIGHT);
     }
 
     // both sensors see white = we totally lost the line
-    // first try reversing for a bit (SEARCH_FWD ticks) to go back where we came from
-    // ir_cnt keeps track of how long weve been lost
+    // sweep toward where we last saw it, then spiral out (see Line_Search)
     else if (left_white && right_white)
     {
-        if (ir_cnt < SEARCH_FWD)
-        {
-            motors_reverse(); // back up first
-        }
-        else
-        {
-            motors_forward(); // gave up backing up, try going forward
-        }
-        ir_cnt++; // been lost for one more tick
+        Line_Search();
     }
 
     // gray zone - one or both sensors are between WHITE_THRESHOLD and BLACK_THRESHOLD
@@ -128,41 +233,57 @@ void Bang_Bang_Control(void)
             // just keep moving and hope next reading is cleaner
             motors_forward();
         }
-        ir_cnt = 0; // we have at least some info so we're not "lost"
+        // we have at least some info so we're not "lost"
+        if (left_black || right_white)
+        {
+            Line_Found(LEFT);
+        }
+        else if (right_black || left_white)
+        {
+            Line_Found(RIGHT);
+        }
+        else
+        {
+            Line_Found(last_side);
+        }
     }
 
     // line 0: show raw ADC readings so we can see what the sensors are actually doing
 
+    // Right only has room for its hundreds and tens digits.
+    char right_digits[3];
+
     display_line[0][0] = 'L';
     display_line[0][1] = ':';
-    display_line[0][2] = (ADC_Left_Det / 100) % 10 + '0';  // hundreds digit
-    display_line[0][3] = (ADC_Left_Det / 10) % 10 + '0';   // tens digit
-    display_line[0][4] = (ADC_Left_Det) % 10 + '0';        // ones digit
+    Fmt_Dec(&display_line[0][2], ADC_Left_Det, 3, FMT_ZERO);
     display_line[0][5] = ' ';
     display_line[0][6] = 'R';
     display_line[0][7] = ':';
-    display_line[0][8] = (ADC_Right_Det / 100) % 10 + '0';
-    display_line[0][9] = (ADC_Right_Det / 10) % 10 + '0';
+    Fmt_Dec(right_digits, ADC_Right_Det, 3, FMT_ZERO);
+    display_line[0][8] = right_digits[0];
+    display_line[0][9] = right_digits[1];
     display_line[0][10] = '\0';
 
     // line 1: elapsed time display
-    // display_timer gets incremented every time this function runs which is every 200ms
-    unsigned int whole = display_timer / 5;
-    unsigned int tenths = (display_timer % 5) * 2;
-
-
+    // display_timer gets incremented every time this function runs which is every 200ms,
+    // so display_timer * 2 is the time in tenths of a second
     display_line[1][0] = 'T';
     display_line[1][1] = ':';
-    display_line[1][2] = (whole / 100) % 10 + '0';  // hundreds of seconds
-    display_line[1][3] = (whole / 10) % 10 + '0';   // tens of seconds
-    display_line[1][4] = (whole) % 10 + '0';         // ones of seconds
-    display_line[1][5] = '.';
-    display_line[1][6] = tenths + '0';
+    Fmt_Fixed(&display_line[1][2], display_timer * 2, 1, 5, FMT_ZERO);   // "sss.s"
     display_line[1][7] = 's';
     display_line[1][8] = ' ';
     display_line[1][9] = ' ';
     display_line[1][10] = '\0';
 
+    // line 3: lines re-found, and the longest search in seconds (ticks are 50ms,
+    // so ticks / 2 is tenths of a second)
+    display_line[3][0] = 'R';
+    display_line[3][1] = ':';
+    Fmt_Dec(&display_line[3][2], search_count, 2, FMT_ZERO);
+    display_line[3][4] = ' ';
+    Fmt_Fixed(&display_line[3][5], search_max_ticks >> 1, 1, 4, FMT_ZERO);  // "ss.s"
+    display_line[3][9] = (search_fails) ? 'X' : 's';
+    display_line[3][10] = '\0';
 
     display_changed = TRUE;
     update_display = TRUE;
@@ -236,6 +357,7 @@ void Circle_Navigation(void)
             motors_reset();
             Time_Sequence = 0;
             ir_cnt = 0;
+            searching = SEARCH_IDLE;
             strcpy(display_line[2], "Circling  ");
             display_changed = TRUE;
             update_display = TRUE;
@@ -280,13 +402,7 @@ void Circle_Navigation(void)
             P2OUT &= ~IR_LED;
             display_line[1][0] = 'T';
             display_line[1][1] = ':';
-            unsigned int w = display_timer / 5;
-            unsigned int t = (display_timer % 5) * 2;
-            display_line[1][2] = (w / 100) % 10 + '0';
-            display_line[1][3] = (w / 10) % 10 + '0';
-            display_line[1][4] = (w) % 10 + '0';
-            display_line[1][5] = '.';
-            display_line[1][6] = t + '0';
+            Fmt_Fixed(&display_line[1][2], display_timer * 2, 1, 5, FMT_ZERO);
             display_line[1][7] = 's';
             display_line[1][8] = ' ';
             display_line[1][9] = ' ';
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+// File:    quant.c
+// Author:  Noah Cartwright
+// Date:    April 9, 2026
+// Course:  ECE 306 — Introduction to Embedded Systems
+//
+// Description:
+//   Hysteresis quantizer (see quant.h).  The per-sample path in the ADC ISR
+//   is one add and one compare; the filter, velocity and zone search run
+//   once per 2^QUANT_DECIM_SHIFT samples.  Boundaries are compared as
+//   (value * zones) against (edge * zones), so equal zones need no
+//   division.
+//
+//   Sharing with the ISR: Quant_Config masks ADCIE0 while it rewrites the
+//   configuration, so Quant_Feed never runs on half of it.  Quant_Event
+//   reads the one-byte index once and needs no masking.
+//------------------------------------------------------------------------------
+
+#include  "msp430.h"
+#include  <stddef.h>
+#include  "ports.h"
+#include  "macros.h"
+#include  "quant.h"
+
+#define QUANT_VEL_SHIFT     (2)     // Velocity smoothing, 1/4 per block
+
+//------------------------------------------------------------------------------
+// Function: quant_edge
+// Description: Boundary k (1 .. zones-1) in the same units as
+//              filt * zones.
+//------------------------------------------------------------------------------
+static unsigned long quant_edge(const volatile quant_t *q, unsigned char zones,
+                                unsigned char k)
+{
+    if (q->edges != NULL)
+    {
+        return ((unsigned long)q->edges[k - 1u] << QUANT_FRAC) * zones;
+    }
+    return (unsigned long)k << (QUANT_ADC_BITS + QUANT_FRAC);
+}
+
+//------------------------------------------------------------------------------
+// Function: quant_locate
+// Description: Moves index from i toward the filtered value, one boundary at
+//              a time; a boundary is only crossed hyst counts past it.
+// Parameters:  q     — quantizer
+//              zones — zone count (Quant_Config passes the new one)
+//              hyst  — counts of hysteresis (0 = plain quantizing)
+//              i     — starting index
+// Returns:     New index
+//------------------------------------------------------------------------------
+static unsigned char quant_locate(const volatile quant_t *q,
+                                  unsigned char zones, unsigned char hyst,
+                                  unsigned char i)
+{
+    unsigned long x = (unsigned long)q->filt * zones;
+    unsigned long h = ((unsigned long)hyst << QUANT_FRAC) * zones;
+
+    while ((unsigned char)(i + 1u) < zones && x >= quant_edge(q, zones, i + 1u) + h)
+    {
+        i++;
+    }
+    while (i > 0u && x + h < quant_edge(q, zones, i))
+    {
+        i--;
+    }
+    return i;
+}
+
+//==============================================================================
+// Function: Quant_Feed
+// Description:
+//   ADC ISR — one raw conversion.  Every 2^QUANT_DECIM_SHIFT samples the
+//   block average goes through the filter, updates the velocity and moves
+//   the index past any boundary it has cleared by hyst.
+// Parameters:  q   — quantizer
+//              raw — conversion result (0 .. QUANT_ADC_MAX)
+// Returns:     None
+//==============================================================================
+void Quant_Feed(volatile quant_t *q, unsigned int raw)
+{
+    unsigned int x;
+    unsigned int prev;
+    int          dv;
+
+    q->sum += raw;
+    if (++q->count < (1u << QUANT_DECIM_SHIFT))
+    {
+        return;
+    }
+    x        = q->sum >> (QUANT_DECIM_SHIFT - QUANT_FRAC);     // Q4 average
+    q->sum   = 0;
+    q->count = 0;
+
+    if (!q->primed)
+    {
+        q->filt   = x;
+        q->primed = TRUE;
+    }
+    prev = q->filt;
+    if (q->filter != 0u)
+    {
+        q->filt = (unsigned int)((int)prev + (((int)x - (int)prev) >> q->filter));
+    }
+    else
+    {
+        q->filt = x;
+    }
+
+    dv           = (int)q->filt - (int)prev;
+    q->velocity += (dv - q->velocity) >> QUANT_VEL_SHIFT;
+
+    if (q->zones != 0u)
+    {
+        q->index = quant_locate(q, q->zones, q->hyst, q->index);
+    }
+}
+
+//==============================================================================
+// Function: Quant_Config
+// Description:
+//   Main loop — (re)defines the zones and takes the current filtered value's
+//   zone as the index, without hysteresis and without raising an event.
+// Parameters:  q      — quantizer
+//              zones  — 1 .. QUANT_MAX_ZONES
+//              edges  — zones-1 ascending ADC values, or NULL for equal zones
+//              hyst   — counts each side of every boundary
+//              filter — IIR shift, 0 = block average only
+// Returns:     None
+//==============================================================================
+void Quant_Config(volatile quant_t *q, unsigned char zones,
+                  const unsigned int *edges, unsigned char hyst,
+                  unsigned char filter)
+{
+    unsigned int ie = ADCIE & ADCIE0;
+
+    if (zones == 0u)
+    {
+        zones = 1u;
+    }
+    if (zones > QUANT_MAX_ZONES)
+    {
+        zones = QUANT_MAX_ZONES;
+    }
+
+    ADCIE      &= ~ADCIE0;              // Quant_Feed waits until we finish
+    q->edges    = edges;
+    q->hyst     = hyst;
+    q->filter   = filter;
+    q->zones    = zones;
+    q->index    = quant_locate(q, zones, 0u, 0u);
+    q->reported = q->index;
+    ADCIE      |= ie;
+}
+
+//==============================================================================
+// Function: Quant_Event
+// Description:
+//   Main loop — TRUE once per change of index since the last event (or
+//   Quant_Config).  A change that returned to the reported index before
+//   the poll is no event.
+// Parameters:  q    — quantizer
+//              from — out: index at the previous event
+//              to   — out: index now
+// Returns:     TRUE if the index changed
+//==============================================================================
+unsigned char Quant_Event(volatile quant_t *q, unsigned char *from,
+                          unsigned char *to)
+{
+    unsigned char now = q->index;
+
+    if (now == q->reported)
+    {
+        return FALSE;
+    }
+    *from       = q->reported;
+    *to         = now;
+    q->reported = now;
+    return TRUE;
+}
+
+unsigned char Quant_Index(const volatile quant_t *q)
+{
+    return q->index;
+}
+
+//------------------------------------------------------------------------------
+// Function: Quant_Velocity
+// Returns: Smoothed Q4 counts per block; negative while turning CCW
+//          (reading falling), near 0 at rest
+//------------------------------------------------------------------------------
+int Quant_Velocity(const volatile quant_t *q)
+{
+    return q->velocity;
+}
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+// File:    quant.h
+// Author:  Noah Cartwright
+// Date:    April 9, 2026
+// Course:  ECE 306 — Introduction to Embedded Systems
+//
+// Description:
+//   Hysteresis quantizer for an ADC channel (the thumbwheel).  Quant_Feed
+//   runs in the ADC ISR on every conversion of the channel; the main loop
+//   configures the zones with Quant_Config and polls Quant_Event, which
+//   reports an index change once.
+//
+//   PIPELINE (per instance)
+//   ───────────────────────
+//   1. Block average of 2^QUANT_DECIM_SHIFT raw samples (adds only)
+//   2. Optional IIR low-pass, 1/2^filter per block (0 = off)
+//   3. Velocity: smoothed change of the filtered value per block
+//   4. Zones: a move past a boundary only counts once the reading is hyst
+//      counts beyond it, in either direction, at every boundary — so a
+//      wheel resting on a boundary holds its index instead of flickering
+//
+//   Boundaries are equal divisions of the ADC range, or an explicit table
+//   of zones-1 ascending ADC values.
+//------------------------------------------------------------------------------
+
+#ifndef QUANT_H_
+#define QUANT_H_
+
+#define QUANT_ADC_BITS      (10)    // ADCRES_1
+#define QUANT_ADC_MAX       ((1u << QUANT_ADC_BITS) - 1u)
+#define QUANT_MAX_ZONES     (64)    // ADC_MAX * zones fits 16 bits
+#define QUANT_DECIM_SHIFT   (6)     // 64 samples per block: sum fits 16 bits
+#define QUANT_FRAC          (4)     // Filtered value / velocity are Q4 counts
+
+typedef struct
+{
+    // Configuration — written by Quant_Config with ADCIE0 masked
+    const unsigned int *edges;      // zones-1 ascending ADC values, or NULL
+    unsigned char       zones;      // 0 = not configured (filter still runs)
+    unsigned char       hyst;       // Counts each side of every boundary
+    unsigned char       filter;     // IIR shift, 0 = off
+
+    // ISR state
+    unsigned int        sum;        // Current block
+    unsigned char       count;
+    unsigned char       primed;     // filt holds a real reading
+    unsigned int        filt;       // Q4 counts
+    int                 velocity;   // Q4 counts per block, smoothed; < 0 = CCW
+    unsigned char       index;
+
+    // Main-loop state
+    unsigned char       reported;   // Index at the last Quant_Event
+} quant_t;
+
+extern volatile quant_t ADC_Thumb_Q;    // ADC.c, fed with every A5 conversion
+
+// Instances are shared with the ADC ISR, hence volatile throughout.
+void          Quant_Feed(volatile quant_t *q, unsigned int raw);
+void          Quant_Config(volatile quant_t *q, unsigned char zones,
+                           const unsigned int *edges, unsigned char hyst,
+                           unsigned char filter);
+unsigned char Quant_Event(volatile quant_t *q, unsigned char *from,
+                          unsigned char *to);
+unsigned char Quant_Index(const volatile quant_t *q);
+int           Quant_Velocity(const volatile quant_t *q);
+
+#endif /* QUANT_H_ */
@@ -6,18 +6,19 @@
  *              AD2 TX -> J9 RX (P1.6 / UCA0RXD)
  *              AD2 RX <- J9 TX (P1.7 / UCA0TXD)
  *
- * Baud rate register values for SMCLK = 8 MHz, oversampling mode (UCOS16 = 1):
+ * Baud rate register values are computed from MCLK_FREQ_MHZ at compile
+ * time (baud.h).  At SMCLK = 8 MHz, oversampling mode (UCOS16 = 1):
  *
  *   115,200 baud:  N = 69.444
  *     UCBRx  = INT(N/16)              = 4
  *     UCBRFx = INT(frac(N/16) * 16)  = 5
- *     UCBRSx = table[frac(N)=0.444]  = 0x55   (Table 18-4)
+ *     UCBRSx = table[frac(N)=0.444]  = 0x55
  *     MCTLW  = 0x5551
  *
  *   460,800 baud:  N = 17.361  (> 16, oversampling required)
  *     UCBRx  = INT(N/16)              = 1
  *     UCBRFx = INT(frac(N/16) * 16)  = 1
- *     UCBRSx = table[frac(N)=0.361]  = 0x4A   (Table 18-4)
+ *     UCBRSx = table[frac(N)=0.361]  = 0x4A
  *     MCTLW  = 0x4A11
  *
  * Author:  Noah Cartwright
@@ -32,22 +33,29 @@
 #include "ports.h"
 #include "macros.h"
 #include "globals.h"
+#include "profile.h"
+#include "baud.h"
 
 //------------------------------------------------------------------------------
-// Baud rate register values (SMCLK = 8 MHz, UCOS16 = 1)
+// Baud rate register values (baud.h).  At SMCLK = 8 MHz:
 //
 //   115,200: N=69.44  UCBRx=4,  UCBRFx=5,  UCBRSx=0x55  MCTLW=0x5551
-//     9,600: N=833.3  UCBRx=52, UCBRFx=1,  UCBRSx=0x49  MCTLW=0x4911
+//     9,600: N=833.3  UCBRx=52, UCBRFx=1,  UCBRSx=0x25  MCTLW=0x2511
 //   460,800: N=17.36  UCBRx=1,  UCBRFx=1,  UCBRSx=0x4A  MCTLW=0x4A11
 //------------------------------------------------------------------------------
-#define UCBRx_115200    (4)
-#define MCTLW_115200    (0x5551)
+#if !BAUD_OK(BAUD_BRCLK_HZ, UART_BAUD_115200) || !BAUD_OK(BAUD_BRCLK_HZ, UART_BAUD_9600) \
+    || !BAUD_OK(BAUD_BRCLK_HZ, UART_BAUD_460800)
+#error "UART bit-rate error over BAUD_ERR_MAX_PPM at this clock (baud.h)"
+#endif
 
-#define UCBRx_9600      (52)
-#define MCTLW_9600      (0x4911)
+#define UCBRx_115200    BAUD_BRW(BAUD_BRCLK_HZ, UART_BAUD_115200)
+#define MCTLW_115200    BAUD_MCTLW(BAUD_BRCLK_HZ, UART_BAUD_115200)
 
-#define UCBRx_460800    (1)
-#define MCTLW_460800    (0x4A11)
+#define UCBRx_9600      BAUD_BRW(BAUD_BRCLK_HZ, UART_BAUD_9600)
+#define MCTLW_9600      BAUD_MCTLW(BAUD_BRCLK_HZ, UART_BAUD_9600)
+
+#define UCBRx_460800    BAUD_BRW(BAUD_BRCLK_HZ, UART_BAUD_460800)
+#define MCTLW_460800    BAUD_MCTLW(BAUD_BRCLK_HZ, UART_BAUD_460800)
 
 //------------------------------------------------------------------------------
 // Baud rate display strings (10 chars, centered on 10-char LCD)
@@ -586,6 +594,9 @@ void Serial_Process(void)
 
     // Steps 56-58: handle incoming TCP commands from Java client
     IOT_IPD_Process();
+
+    // ^P report, one line per free UCA1 transmitter
+    Prof_Process();
 }
 
 //------------------------------------------------------------------------------
@@ -645,6 +656,7 @@ void Update_Baud_Display(char baud_sel)
 //   ^       (empty / ^^) → respond "I'm here"
 //   F       (^F)         → set UCA0 to 115,200; respond "115,200"
 //   S       (^S)         → set UCA0 to   9,600; respond "9,600"
+//   P / PR  (^P, ^PR)    → ISR profile report (profile.h); PR then resets
 //------------------------------------------------------------------------------
 void IOT_Command_Process(void)
 {
@@ -666,6 +678,10 @@ void IOT_Command_Process(void)
         Change_Baud_Rate(BAUD_9600);
         Transmit_UCA1_String(resp_slow);
         Update_Baud_Display(BAUD_9600);
+
+    } else if (cmd_buf[0] == 'P') {
+        // ^P — ISR profile report; ^PR also clears it afterwards
+        Prof_Report_Start(cmd_buf[1] == 'R');
     }
 }
 
@@ -682,6 +698,8 @@ void IOT_Command_Process(void)
 __interrupt void eUSCI_A0_ISR(void)
 {
     char c;
+    PROF_ENTER();
+
     switch (__even_in_range(UCA0IV, 0x08))
     {
         case 0x00: break;
@@ -713,6 +731,8 @@ __interrupt void eUSCI_A0_ISR(void)
 
         default: break;
     }
+
+    PROF_EXIT(PROF_UCA0);
 }
 
 //------------------------------------------------------------------------------
@@ -752,6 +772,8 @@ void Transmit_UCA1_String(const char *s)
 __interrupt void eUSCI_A1_ISR(void)
 {
     char temp;
+    PROF_ENTER();
+
     switch (__even_in_range(UCA1IV, 0x08))
     {
         case 0x00: break;
@@ -793,4 +815,6 @@ __interrupt void eUSCI_A1_ISR(void)
 
         default: break;
     }
+
+    PROF_EXIT(PROF_UCA1);
 }
@@ -13,6 +13,7 @@
 #include  "ports.h"
 #include "macros.h"
 #include "globals.h"
+#include "profile.h"
 
 volatile unsigned int Time_Sequence    = RESET_STATE;
 volatile char         one_time         = FALSE;
@@ -94,6 +95,9 @@ void Init_Timer_B3(void){
 #pragma vector = TIMER0_B0_VECTOR
 __interrupt void Timer0_B0_ISR(void)
 {
+    PROF_ENTER();
+    PROF_LATENCY_TB0(PROF_TB0_CCR0, TB0CCR0);
+
     one_time = TRUE;
     Time_Sequence++;
     update_display = TRUE;
@@ -114,6 +118,8 @@ __interrupt void Timer0_B0_ISR(void)
     }
 
     TB0CCR0 += TB0CCR0_INTERVAL;
+
+    PROF_EXIT(PROF_TB0_CCR0);
 }
 //------------------------------------------------------------------------------
 // TIMER0_B1_ISR - handles CCR1 (SW1 debounce) and CCR2 (SW2 debounce)
@@ -122,12 +128,15 @@ __interrupt void Timer0_B0_ISR(void)
 #pragma vector = TIMER0_B1_VECTOR
 __interrupt void TIMER0_B1_ISR(void)
 {
+    PROF_ENTER();
+
     switch (__even_in_range(TB0IV, TB0IV_MAX))
     {
         case TB0IV_NO:
             break;
 
         case TB0IV_CCR1:  // SW1 debounce
+            PROF_LATENCY_TB0(PROF_TB0_CCR12, TB0CCR1);
             if (sw1_debounce_active)
             {
                 sw1_debounce_count++;
@@ -144,6 +153,7 @@ __interrupt void TIMER0_B1_ISR(void)
             break;
 
         case TB0IV_CCR2:  // SW2 debounce
+            PROF_LATENCY_TB0(PROF_TB0_CCR12, TB0CCR2);
             if (sw2_debounce_active)
             {
                 sw2_debounce_count++;
@@ -160,6 +170,7 @@ __interrupt void TIMER0_B1_ISR(void)
             break;
 
         case TB0IV_OVERFLOW:
+            PROF_LATENCY_TB0(PROF_TB0_CCR12, 0);    // Wrapped at 0
             DAC_data = DAC_data - 100;
                 SAC3DAT  = DAC_data;
                 if(DAC_data <= DAC_Limit){
@@ -173,6 +184,8 @@ __interrupt void TIMER0_B1_ISR(void)
         default:
             break;
     }
+
+    PROF_EXIT(PROF_TB0_CCR12);
 }
 
 //------------------------------------------------------------------------------
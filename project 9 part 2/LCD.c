@@ -0,0 +1,284 @@
+//==============================================================================
+// File:        LCD.c
+// Description: Source replacement for Carlson's LCD.obj (same LCD.h API) on
+//              the DOGS104 (SSD1803A) LCD, eUSCI_B1 3-wire SPI, LSB first:
+//                P4.0 = RESET_LCD, P4.4 = UCB1_CS_LCD (GPIO)
+//                P4.5 = UCB1CLK,   P4.6 = UCB1SIMO
+//
+//              Every instruction or data byte is one chip-select frame of
+//              three SPI bytes: START_WR_INSTRUCTION / START_WR_DATA, low
+//              nibble, high nibble -- the framing LCD.obj uses.
+//
+//              LCD.obj busy-waited on UCB1IFG for every SPI byte (~13 ms
+//              for a four-line Display_Update).  Here WriteIns / WriteData
+//              only push the byte onto lcd_queue and return; eUSCI_B1_ISR
+//              clocks the queue out, one SPI byte per UCRXIFG (i.e. once the
+//              previous byte has fully left the shift register, which is
+//              also when chip select may go high).  lcd_frame_done is 1
+//              whenever the queue has drained.
+//
+//              Only Init_LCD blocks: the reset pulse and power-on waits.
+//              LCD_test (serial-terminal demo) is not carried over.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "msp430.h"
+#include "macros.h"
+#include "ports.h"
+#include "LCD.h"
+
+//------------------------------------------------------------------------------
+// Display globals the rest of the project declares extern (init.c,
+// display.c, interrupts_timers.c).  No file in this tree defined
+// update_display; it lives here with the others.
+//------------------------------------------------------------------------------
+char                   display_line[4][11];
+char                  *display[4];
+volatile unsigned char display_changed = 0;
+volatile unsigned char update_display  = 0;
+
+volatile unsigned char lcd_frame_done  = 1;
+
+//------------------------------------------------------------------------------
+// Transfer queue.  Entries are the byte in bits 0-7 plus LCD_Q_DATA; written
+// at the tail by the main loop, consumed at the head by the ISR.
+//------------------------------------------------------------------------------
+#define LCD_Q_DATA          (0x0100)
+
+static volatile unsigned int  lcd_queue[LCD_QUEUE_SIZE];
+static volatile unsigned char lcd_q_head = 0;
+static volatile unsigned char lcd_q_tail = 0;
+static volatile unsigned char lcd_busy   = 0;   // A frame is on the wire
+
+static unsigned char lcd_frame[3];              // Current chip-select frame
+static unsigned char lcd_frame_idx = 0;         // Next byte of it to send
+static unsigned char lcd_orient    = 0;
+
+//------------------------------------------------------------------------------
+// lcd_next -- ISR side: pull the next queue entry and start its frame.
+//------------------------------------------------------------------------------
+static void lcd_next(void){
+    unsigned int op = lcd_queue[lcd_q_head];
+
+    lcd_q_head   = (unsigned char)((lcd_q_head + 1) & LCD_QUEUE_MASK);
+    lcd_frame[0] = (op & LCD_Q_DATA) ? START_WR_DATA : START_WR_INSTRUCTION;
+    lcd_frame[1] = (unsigned char)(op & 0x0F);
+    lcd_frame[2] = (unsigned char)((op >> 4) & 0x0F);
+    lcd_frame_idx = 1;
+    P4OUT &= ~UCB1_CS_LCD;
+    UCB1TXBUF = lcd_frame[0];
+}
+
+//------------------------------------------------------------------------------
+// lcd_put -- main-loop side: queue one byte and start the ISR if idle.  A full
+// queue (more than LCD_QUEUE_SIZE bytes outstanding) waits for the ISR to
+// make room, so interrupts must be enabled.
+//------------------------------------------------------------------------------
+static void lcd_put(unsigned int op){
+    unsigned char next = (unsigned char)((lcd_q_tail + 1) & LCD_QUEUE_MASK);
+
+    while(next == lcd_q_head);
+
+    UCB1IE &= ~UCRXIE;
+    lcd_queue[lcd_q_tail] = op;
+    lcd_q_tail     = next;
+    lcd_frame_done = 0;
+    if(!lcd_busy){
+        lcd_busy = 1;
+        lcd_next();
+    }
+    UCB1IE |=  UCRXIE;
+}
+
+//==============================================================================
+// eUSCI_B1_ISR -- one SPI byte has been shifted out.
+//==============================================================================
+#pragma vector = EUSCI_B1_VECTOR
+__interrupt void eUSCI_B1_ISR(void){
+    switch(__even_in_range(UCB1IV, 0x04)){
+        case 2:                                 // RX: byte done
+            (void)UCB1RXBUF;
+            if(lcd_frame_idx < 3){
+                UCB1TXBUF = lcd_frame[lcd_frame_idx++];
+                break;
+            }
+            P4OUT |= UCB1_CS_LCD;               // end of frame
+            if(lcd_q_head != lcd_q_tail){
+                __delay_cycles(LCD_CS_HIGH_CYCLES);
+                lcd_next();
+            } else {
+                lcd_busy       = 0;
+                lcd_frame_done = 1;
+            }
+            break;
+
+        default: break;
+    }
+}
+
+//==============================================================================
+// Low level
+//==============================================================================
+void WriteIns(char instruction){
+    lcd_put((unsigned char)instruction);
+}
+
+void WriteData(char data){
+    lcd_put((unsigned int)(unsigned char)data | LCD_Q_DATA);
+}
+
+//------------------------------------------------------------------------------
+// Init_SPI_B1 -- SMCLK / LCD_SPI_BRW, clock idles high, master, 3-pin, LSB
+// first (the SSD1803A serial format).
+//------------------------------------------------------------------------------
+void Init_SPI_B1(void){
+    UCB1CTLW0  = UCSWRST;
+    UCB1CTLW0 |= UCSSEL__SMCLK;
+    UCB1BRW    = LCD_SPI_BRW;
+    UCB1CTLW0 |= UCCKPL | UCMST | UCSYNC;
+    UCB1CTLW0 &= ~UCMSB;
+    UCB1CTLW0 &= ~UCSWRST;
+    UCB1IE    |= UCRXIE;
+}
+
+//==============================================================================
+// Init_LCD -- reset pulse, then the SSD1803A power-on sequence LCD.obj sends.
+// Called from main() after Init_Conditions has enabled interrupts.
+//==============================================================================
+void Init_LCD(void){
+    Init_SPI_B1();
+    P4OUT |= UCB1_CS_LCD;
+    P4OUT |= RESET_LCD;
+    __delay_cycles(LCD_SHORT_DELAY);
+    P4OUT &= ~RESET_LCD;
+    __delay_cycles(LCD_RESET_DELAY);
+    P4OUT |= RESET_LCD;
+    __delay_cycles(LCD_RESET_DELAY);
+
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | RE_BIT);       // 0x3A
+    WriteIns(EXTENDED_FUNCTION_SET | NW_BIT);               // 0x09 4 lines
+    WriteIns(TOP);                                          // 0x06
+    WriteIns(DH_BIAS_DOT_SHIFT | UD2_BIT | UD1_BIT | BS1_BIT); // 0x1E
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | IS_BIT);       // 0x39
+    WriteIns(INTERNAL_OSC_FREQ | BS0_BIT | F1_BIT | F0_BIT);   // 0x1B
+    WriteIns(FOLLOWER_CONTROL | DON_BIT | RAB2_BIT | RAB1_BIT); // 0x6E
+    WriteIns(POWER_CONTROL | BON_BIT | C5_BIT | C4_BIT);    // 0x57
+    WriteIns(0x7F);                                         // contrast C3-C0
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT);                // 0x38
+    ClrDisplay();
+    DisplayOnOff(DISPLAY_ON);
+}
+
+//==============================================================================
+// Layouts (all set display_changed so the next refresh redraws)
+//==============================================================================
+void lcd_BIG_mid(void){
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | RE_BIT);
+    WriteIns(DH_BIAS_DOT_SHIFT | UD1_BIT | BS1_BIT | DH2_BIT);  // 0x17
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | DH_BIT);
+    display_changed = 1;
+}
+
+void lcd_BIG_bot(void){
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | RE_BIT);
+    WriteIns(DH_BIAS_DOT_SHIFT | BS1_BIT | DH2_BIT);            // 0x13
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | DH_BIT);
+    display_changed = 1;
+}
+
+void lcd_4line(void){
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT);
+    display_changed = 1;
+}
+
+void lcd_180(void){
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | RE_BIT);
+    if(!lcd_orient){
+        lcd_orient = 1;
+        WriteIns(BOTTOM);
+    } else {
+        lcd_orient = 0;
+        WriteIns(TOP);
+    }
+    WriteIns(FUNCTION_SET | DL_BIT | N_BIT | DH_BIT);
+    display_changed = 1;
+}
+
+//==============================================================================
+// Text
+//==============================================================================
+void SetPostion(char pos){
+    WriteIns((char)(pos + LCD_HOME_L1));        // DDRAM address command
+    display_changed = 0;
+}
+
+void DisplayOnOff(char data){
+    WriteIns((char)(DISPLAY_CONTROL + data));
+    display_changed = 0;
+}
+
+void lcd_puts(char *s){
+    while(*s){
+        WriteData(*s++);
+    }
+}
+
+void lcd_out(char *s, char line, char position){
+    WriteIns((char)(line + position));
+    lcd_puts(s);
+}
+
+void Display_Update(char p_L1, char p_L2, char p_L3, char p_L4){
+    lcd_out(display_line[0], LCD_HOME_L1, p_L1);
+    lcd_out(display_line[1], LCD_HOME_L2, p_L2);
+    lcd_out(display_line[2], LCD_HOME_L3, p_L3);
+    lcd_out(display_line[3], LCD_HOME_L4, p_L4);
+}
+
+void update_string(char *string_data, int string){
+    char *dst = display_line[string];
+
+    while(*string_data){
+        *dst++ = *string_data++;
+    }
+}
+
+//==============================================================================
+// Buffers
+//==============================================================================
+static void lcd_clr_buffer(char *line){
+    unsigned int i;
+
+    for(i = 0; i < 10; i++){
+        line[i] = ' ';
+    }
+}
+
+void ClrDisplay_Buffer_0(void){ lcd_clr_buffer(display_line[0]); }
+void ClrDisplay_Buffer_1(void){ lcd_clr_buffer(display_line[1]); }
+void ClrDisplay_Buffer_2(void){ lcd_clr_buffer(display_line[2]); }
+void ClrDisplay_Buffer_3(void){ lcd_clr_buffer(display_line[3]); }
+
+void ClrDisplay(void){
+    ClrDisplay_Buffer_0();
+    ClrDisplay_Buffer_1();
+    ClrDisplay_Buffer_2();
+    ClrDisplay_Buffer_3();
+    display_changed = 0;
+}
+
+//==============================================================================
+// Misc
+//==============================================================================
+unsigned char CheckBusy(void){
+    return !lcd_frame_done;
+}
+
+void enable_display_update(void){
+    TB0CCR2   = 12500;
+    TB0CCTL2 |= CCIE;
+}
@@ -5,12 +5,8 @@
 void enable_display_update(void);
 void update_string(char *string_data, int string);
 void Init_LCD(void);
-void lcd_clear(void);
-void lcd_putc(char c);
 void lcd_puts(char *s);
 
-void Write_LCD_Ins(char instruction);
-void Write_LCD_Data(char data);
 void ClrDisplay(void);
 void ClrDisplay_Buffer_0(void);
 void ClrDisplay_Buffer_1(void);
@@ -24,22 +20,9 @@ void lcd_BIG_mid(void);
 void lcd_BIG_bot(void);
 void lcd_4line(void);
 void lcd_out(char *s, char line, char position);
-void lcd_rotate(char view);
 
-//void lcd_write(char data, char command);
-void lcd_write(unsigned char c);
-void lcd_write_line1(void);
-void lcd_write_line2(void);
-void lcd_write_line3(void);
-
-
-void lcd_command( char data);
-void LCD_test(void);
 void Display_Process(void);
 void Display_Update(char p_L1,char p_L2,char p_L3,char p_L4);
-int wait_for_character(void);
-void print_CR(void);
-void outchar(char character);
 
 //------------------------------------------------------------------------------
 
@@ -109,3 +92,20 @@ void outchar(char character);
 #define START_WR_INSTRUCTION  0x1f
 #define START_WR_DATA         0x5f
 
+//------------------------------------------------------------------------------
+// LCD.c driver
+//------------------------------------------------------------------------------
+extern volatile unsigned char lcd_frame_done;   // 1 = transfer queue drained
+void Init_SPI_B1(void);
+void WriteIns(char instruction);
+void WriteData(char data);
+void lcd_180(void);
+__interrupt void eUSCI_B1_ISR(void);
+
+#define LCD_SPI_HZ            (100000UL) // SPI bit rate, as LCD.obj
+#define LCD_SPI_BRW           ((unsigned int)(SMCLK_HZ / LCD_SPI_HZ))
+#define LCD_QUEUE_SIZE        (64)      // Power of two; > one full frame
+#define LCD_QUEUE_MASK        (LCD_QUEUE_SIZE - 1)
+#define LCD_CS_HIGH_CYCLES    (MCLK_FREQ_MHZ * 1UL)     // 1 us chip-select high between bytes
+#define LCD_SHORT_DELAY       (MCLK_FREQ_MHZ * 1000UL)  // 1 ms
+#define LCD_RESET_DELAY       (MCLK_FREQ_MHZ * 25000UL) // 25 ms, reset low / power-on settle
@@ -1,7 +1,9 @@
 //==============================================================================
 // File: adc.c
-// Description: 12-bit ADC sequencer for Project 9 Part 2.  Cycles through
-//              A2 (V_DETECT_L), A3 (V_DETECT_R), A5 (V_THUMB) continuously.
+// Description: 12-bit ADC sequencer for Project 9 Part 2.  Each sweep reads
+//              A2 (V_DETECT_L), A3 (V_DETECT_R), A5 (V_THUMB) and A10 (V_DAC,
+//              the motor rail) back to back, then waits for the Timer B1
+//              control clock to start the next.
 //              Ported from Project 7.
 //==============================================================================
 
@@ -14,17 +16,20 @@
 volatile unsigned int ADC_Left_Detect  = 0;
 volatile unsigned int ADC_Right_Detect = 0;
 volatile unsigned int ADC_Thumb        = 0;
+volatile unsigned int ADC_Rail         = 0;
 
 static volatile unsigned int adc_channel = 0;  // Which channel we just read
 
 volatile unsigned int ir_emitter_on = 0;
 
-// Set when the ADC ISR finishes a full A2->A3->A5 sweep.
-volatile unsigned char ADC_sample_ready = 0;
+// Bumped when the ADC ISR finishes a full A2->A3->A5->A10 sweep.
+volatile unsigned int ADC_frame_count    = 0;
+volatile unsigned int ADC_sweep_overruns = 0;
 
 #define ADC_SEQ_LEFT   (0)
 #define ADC_SEQ_RIGHT  (1)
 #define ADC_SEQ_THUMB  (2)
+#define ADC_SEQ_RAIL   (3)
 
 void Init_ADC(void){
     ADCCTL0 = 0;
@@ -45,8 +50,20 @@ void Init_ADC(void){
 
     ADCIE |= ADCIE0;                    // Conversion-complete IRQ
 
-    ADCCTL0 |= ADCENC;
-    ADCCTL0 |= ADCSC;                   // Kick off first conversion
+    ADCCTL0 |= ADCENC;                  // First sweep waits for Timer B1
+}
+
+//==============================================================================
+// ADC_Start_Sweep -- called from Timer1_B0_ISR once per control period.  If
+// the previous sweep has not finished, skip this one and count it rather
+// than corrupting the channel sequence.
+//==============================================================================
+void ADC_Start_Sweep(void){
+    if(adc_channel != ADC_SEQ_LEFT){
+        ADC_sweep_overruns++;
+        return;
+    }
+    ADCCTL0 |= ADCSC;
 }
 
 #pragma vector = ADC_VECTOR
@@ -68,16 +85,23 @@ __interrupt void ADC_ISR(void){
                 case ADC_SEQ_THUMB:
                     ADC_Thumb = ADCMEM0;
                     ADCMCTL0 &= ~ADCINCH_15;
+                    ADCMCTL0 |=  ADCINCH_10;
+                    break;
+                case ADC_SEQ_RAIL:
+                    ADC_Rail = ADCMEM0;
+                    ADCMCTL0 &= ~ADCINCH_15;
                     ADCMCTL0 |=  ADCINCH_2;
                     adc_channel = 0;
-                    ADC_sample_ready = 1;   // Full L/R/Thumb sweep complete
+                    ADC_frame_count++;      // Full sweep complete
                     break;
                 default:
                     adc_channel = 0;
                     break;
             }
             ADCCTL0 |= ADCENC;
-            ADCCTL0 |= ADCSC;
+            if(adc_channel != ADC_SEQ_LEFT){
+                ADCCTL0 |= ADCSC;           // Next channel of this sweep
+            }
             break;
         default:
             break;
@@ -9,15 +9,18 @@
 extern volatile unsigned int ADC_Left_Detect;   // Channel A2 (P1.2)
 extern volatile unsigned int ADC_Right_Detect;  // Channel A3 (P1.3)
 extern volatile unsigned int ADC_Thumb;         // Channel A5 (P1.5)
+extern volatile unsigned int ADC_Rail;          // Channel A10 (P5.2, V_DAC)
 
 extern volatile unsigned int ir_emitter_on;     // 1 = IR LED ON
 
-// Set by the ADC ISR whenever a full L/R/Thumb sweep completes.  The PD
-// line-follow loop reads this flag to gate its update so d_error is always
-// computed on a fresh sample pair rather than a re-read of stale values.
-// Consumer clears it after reading.
-extern volatile unsigned char ADC_sample_ready;
+// Sweeps are started by the Timer B1 control clock (ADC_Start_Sweep).
+// ADC_frame_count advances once per completed L/R/Thumb/Rail sweep; a consumer
+// that remembers the last value it saw knows both that a fresh frame is
+// ready and how many it missed in between.
+extern volatile unsigned int ADC_frame_count;
+extern volatile unsigned int ADC_sweep_overruns; // tick arrived mid-sweep
 
 void Init_ADC(void);
+void ADC_Start_Sweep(void);                     // Timer1_B0_ISR, every period
 
 #endif /* ADC_H_ */
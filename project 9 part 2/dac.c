@@ -12,15 +12,15 @@
 //                Lower SAC3DAT value  -->  higher buck-boost output voltage
 //                Higher SAC3DAT value -->  lower buck-boost output voltage
 //
-//              Startup sequence:
-//                1. Init_DAC() sets SAC3DAT = DAC_Begin (1500) -- safe start
-//                2. Init_DAC() enables Timer B0 overflow interrupt (TBIE)
-//                3. Phase 1 -- overflow ISR counts DAC_ENABLE_TICKS (3) ticks:
-//                   After 3 ticks (~1.6s), ISR enables DAC_ENB and RED LED ON
-//                4. Phase 2 -- ISR decrements DAC_data by DAC_RAMP_STEP (50)
-//                   each tick until DAC_data <= DAC_Limit (1200, ~6V)
-//                5. ISR sets DAC_Adjust, clears TBIE, turns RED LED OFF
-//                6. Motor supply is now ~6V; PWM controls direction/speed
+//              Rail sequencing (see dac.h): Init_DAC loads DAC_Begin and
+//              starts DAC_PROFILE_SOFT_START, which reproduces the Project 7
+//              startup --
+//                1. hold DAC_Begin with DAC_ENB low for DAC_ENABLE_TICKS
+//                   overflows (~1.6 s) so the DAC output settles
+//                2. DAC_ENB high, RED LED on, ramp to DAC_Limit (~6 V) in
+//                   DAC_RAMP_STEP codes per overflow
+//                3. RED LED off, TBIE cleared, DAC_Regulate takes over
+//              Other profiles are started with DAC_Seq_Start (^1234V000n).
 //
 //              P3.5 (DAC_CNTL) is switched to analog mode via P3SELC.
 //              P2.5 (DAC_ENB) starts LOW (from Init_Port2); overflow ISR
@@ -36,12 +36,58 @@
 #include "functions.h"
 #include "macros.h"
 #include "ports.h"
+#include "adc.h"
+#include "dac.h"
+
+#if RAIL_REG_ENABLE && !defined(RAIL_DIVIDER_MEASURED)
+#warning "RAIL_REG_ENABLE with the placeholder RAIL_DIVIDER -- meter the divider first (macros.h)"
+#endif
 
 //==============================================================================
 // Global variables
 //==============================================================================
 volatile unsigned int DAC_data;          // Current 12-bit DAC code (0-4095)
-volatile unsigned int dac_startup_ticks; // Overflow tick counter for DAC_ENB
+volatile unsigned int DAC_rail_counts;   // Filtered V_DAC reading (ADC counts)
+
+static unsigned int rail_acc;            // DAC_rail_counts << RAIL_FILTER_SHIFT
+static unsigned int rail_periods;
+static unsigned int rail_target = 0;     // Regulator setpoint, 0 = off
+
+//==============================================================================
+// Profiles.  Segment codes are clamped to RAIL_DAC_MIN..RAIL_DAC_MAX when
+// played, so a bad table row cannot overdrive the motors.
+//==============================================================================
+static const dac_seg_t dac_soft_start[] = {
+    { DAC_Begin,   DAC_ENABLE_TICKS,                            0 },
+    { DAC_Limit,   (DAC_Begin - DAC_Limit) / DAC_RAMP_STEP,     1 },
+};
+static const dac_seg_t dac_sprint[] = {
+    { DAC_SPRINT_CODE, 2,   1 },
+    { DAC_SPRINT_CODE, DAC_SPRINT_TICKS, 1 },
+    { DAC_Adjust,      4,   1 },
+};
+static const dac_seg_t dac_cruise[] = {
+    { DAC_CRUISE_CODE, 6,   1 },
+};
+static const dac_seg_t dac_normal[] = {
+    { DAC_Adjust,      4,   1 },
+};
+
+#define DAC_SEGS(t)     (t), (unsigned char)(sizeof(t) / sizeof((t)[0]))
+
+static const dac_profile_t dac_profiles[DAC_PROFILE_COUNT] = {
+    { DAC_SEGS(dac_soft_start), RAIL_MV_TO_COUNTS(RAIL_TARGET_MV) },
+    { DAC_SEGS(dac_sprint),     RAIL_MV_TO_COUNTS(RAIL_TARGET_MV) },
+    { DAC_SEGS(dac_cruise),     RAIL_MV_TO_COUNTS(RAIL_CRUISE_MV) },
+    { DAC_SEGS(dac_normal),     RAIL_MV_TO_COUNTS(RAIL_TARGET_MV) },
+};
+
+// Sequencer state (ISR-owned while dac_seq_busy)
+static volatile unsigned char dac_seq_busy    = 0;
+static unsigned char          dac_seq_profile = DAC_PROFILE_SOFT_START;
+static unsigned char          dac_seq_index;   // Segment being played
+static unsigned int           dac_seq_left;    // Overflows left in it
+static int                    dac_seq_step;    // Codes per overflow
 
 //==============================================================================
 // Function: Init_DAC
@@ -78,7 +124,145 @@ void Init_DAC(void){
     // 7. Enable the DAC core last.
     SAC3DAC |= DACEN;
 
-    // 8. Start two-phase ramp sequence via Timer B0 overflow interrupt.
-    dac_startup_ticks = 0;
-    TB0CTL  |= TBIE;
+    // 8. Soft-start profile via the Timer B0 overflow interrupt.
+    DAC_Seq_Start(DAC_PROFILE_SOFT_START);
+}
+
+//------------------------------------------------------------------------------
+// dac_seg_begin -- load segment dac_seq_index of the active profile.  The
+// per-overflow step is worked out once here (integer, rounded toward the
+// start code); the last overflow lands on the exact end code.
+//------------------------------------------------------------------------------
+static void dac_seg_begin(void){
+    const dac_seg_t *seg = &dac_profiles[dac_seq_profile].seg[dac_seq_index];
+    unsigned int code = seg->code;
+
+    if(code < RAIL_DAC_MIN){
+        code = RAIL_DAC_MIN;
+    } else if(code > RAIL_DAC_MAX){
+        code = RAIL_DAC_MAX;
+    }
+    dac_seq_left = seg->ticks ? seg->ticks : 1;
+    dac_seq_step = ((int)code - (int)DAC_data) / (int)dac_seq_left;
+
+    if(seg->enable){
+        P2OUT |=  DAC_ENB;
+        P1OUT |=  RED_LED;                  // RED LED ON -- rail moving
+    } else {
+        P2OUT &= ~DAC_ENB;
+    }
+}
+
+//==============================================================================
+// DAC_Seq_Start -- play a profile from the current code.  Refused for an
+// unknown id, and while the soft-start is still running (nothing else may
+// enable the converter before it has settled).
+//==============================================================================
+unsigned char DAC_Seq_Start(unsigned char profile){
+    if(profile >= DAC_PROFILE_COUNT){
+        return 0;
+    }
+    if(dac_seq_busy && dac_seq_profile == DAC_PROFILE_SOFT_START){
+        return 0;
+    }
+    TB0CTL &= ~TBIE;
+    dac_seq_profile = profile;
+    dac_seq_index   = 0;
+    rail_target     = 0;                    // regulator off while playing
+    dac_seg_begin();
+    dac_seq_busy    = 1;
+    TB0CTL &= ~TBIFG;
+    TB0CTL |=  TBIE;
+    return 1;
+}
+
+//==============================================================================
+// DAC_Seq_Stop -- abandon the profile and hold the current code (regulator
+// stays off until the next profile completes).  ^Q calls it.  Ignored during
+// the soft start, which must not be left with DAC_ENB low or half ramped.
+//==============================================================================
+void DAC_Seq_Stop(void){
+    if(dac_seq_busy && dac_seq_profile == DAC_PROFILE_SOFT_START){
+        return;
+    }
+    TB0CTL      &= ~TBIE;
+    dac_seq_busy = 0;
+    P1OUT       &= ~RED_LED;
+}
+
+unsigned char DAC_Seq_Busy(void){
+    return dac_seq_busy;
+}
+
+unsigned char DAC_Seq_Profile(void){
+    return dac_seq_profile;
+}
+
+//==============================================================================
+// DAC_Seq_Tick -- Timer B0 overflow (TIMER0_B1_ISR case 14), ~0.52 s.
+//==============================================================================
+void DAC_Seq_Tick(void){
+    const dac_profile_t *prof = &dac_profiles[dac_seq_profile];
+
+    if(!dac_seq_busy){
+        TB0CTL &= ~TBIE;
+        return;
+    }
+    if(--dac_seq_left){
+        DAC_data += dac_seq_step;
+    } else {
+        DAC_data = prof->seg[dac_seq_index].code;
+        if(DAC_data < RAIL_DAC_MIN){
+            DAC_data = RAIL_DAC_MIN;
+        } else if(DAC_data > RAIL_DAC_MAX){
+            DAC_data = RAIL_DAC_MAX;
+        }
+        if(++dac_seq_index < prof->count){
+            dac_seg_begin();
+        } else {
+            dac_seq_busy = 0;
+            rail_target  = prof->rail_counts;
+            TB0CTL      &= ~TBIE;           // Disable overflow interrupt
+            P1OUT       &= ~RED_LED;        // RED LED OFF -- rail settled
+        }
+    }
+    SAC3DAT = DAC_data;
+}
+
+//==============================================================================
+// Function: DAC_Regulate
+// Called every control period from Timer1_B0_ISR.  Holds the motor rail at
+// the last profile's setpoint by nudging DAC_data (inverted: lower code =
+// higher rail).  Idle while a profile is playing or after DAC_Seq_Stop.
+//==============================================================================
+void DAC_Regulate(void){
+    unsigned int target = rail_target;
+
+    if(dac_seq_busy || target == 0 || !(P2OUT & DAC_ENB)){
+        rail_acc     = ADC_Rail << RAIL_FILTER_SHIFT;  // start filter on a real value
+        rail_periods = 0;
+        return;
+    }
+    rail_acc       += ADC_Rail - (rail_acc >> RAIL_FILTER_SHIFT);
+    DAC_rail_counts = rail_acc >> RAIL_FILTER_SHIFT;
+
+    if(++rail_periods < RAIL_REG_PERIODS){
+        return;
+    }
+    rail_periods = 0;
+
+#if RAIL_REG_ENABLE
+    if(DAC_rail_counts < RAIL_FAULT_COUNTS){
+        DAC_data = DAC_Adjust;                  // can't see the rail -- don't chase it
+    } else if(DAC_rail_counts + RAIL_DEADBAND < target){
+        if(DAC_data >= RAIL_DAC_MIN + RAIL_DAC_STEP){
+            DAC_data -= RAIL_DAC_STEP;          // rail low -> raise it
+        }
+    } else if(DAC_rail_counts > target + RAIL_DEADBAND){
+        if(DAC_data + RAIL_DAC_STEP <= RAIL_DAC_MAX){
+            DAC_data += RAIL_DAC_STEP;          // rail high -> lower it
+        }
+    }
+    SAC3DAT = DAC_data;
+#endif
 }
@@ -0,0 +1,53 @@
+//==============================================================================
+// File:        dac.h
+// Description: SAC3 DAC / LT1935 buck-boost motor rail (Project 9 Part 2).
+//
+//              The rail is driven by a small sequencer: a profile is a const
+//              table of piecewise-linear segments, each ramping SAC3DAT to a
+//              code over a number of Timer B0 overflows (~0.52 s each) with
+//              DAC_ENB held high or low.  DAC_Seq_Tick plays the active
+//              profile from the overflow ISR; when it ends, DAC_Regulate
+//              holds the profile's rail setpoint (RAIL_REG_ENABLE; off until
+//              RAIL_DIVIDER is measured, so the last code is held as is).
+//              New profiles are table rows in dac.c -- no ISR changes.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef DAC_H_
+#define DAC_H_
+
+// Profile ids (index into dac_profiles[] in dac.c; ^1234V000n selects one)
+#define DAC_PROFILE_SOFT_START  (0)     // Power-on: settle, enable, ramp to 6 V
+#define DAC_PROFILE_SPRINT      (1)     // Short high-voltage boost, then back
+#define DAC_PROFILE_CRUISE      (2)     // Lower rail for long low-power runs
+#define DAC_PROFILE_NORMAL      (3)     // Back to the 6 V operating point
+#define DAC_PROFILE_COUNT       (4)
+
+typedef struct {
+    unsigned int  code;         // SAC3DAT at the end of the segment
+    unsigned int  ticks;        // TB0 overflows to get there (0 = jump)
+    unsigned char enable;       // DAC_ENB level during the segment
+} dac_seg_t;
+
+typedef struct {
+    const dac_seg_t *seg;
+    unsigned char    count;
+    unsigned int     rail_counts;   // DAC_Regulate setpoint afterwards (0 = hold code)
+} dac_profile_t;
+
+extern volatile unsigned int DAC_data;          // Current 12-bit DAC code
+extern volatile unsigned int DAC_rail_counts;   // Filtered V_DAC reading
+
+void          Init_DAC(void);
+unsigned char DAC_Seq_Start(unsigned char profile); // 0 = refused
+void          DAC_Seq_Stop(void);                   // Freeze at current code (^Q)
+unsigned char DAC_Seq_Busy(void);
+unsigned char DAC_Seq_Profile(void);                // Playing, or last played
+void          DAC_Seq_Tick(void);                   // TB0 overflow ISR
+void          DAC_Regulate(void);                   // Timer1_B0_ISR
+
+#endif /* DAC_H_ */
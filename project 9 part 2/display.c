@@ -1,6 +1,22 @@
 //==============================================================================
 // File Name: display.c
 // Description: display related files
+//
+//              Writers change display_line[][] and say which lines they
+//              touched (Display_Line / Display_Mark); nothing goes to the
+//              LCD until the next 200 ms update_display tick, so any number
+//              of updates inside one frame cost one refresh.  The refresh
+//              compares each marked line against display_shown (what the
+//              glass holds) and sends only the run from the first to the
+//              last changed cell -- an unchanged line sends nothing.
+//
+//              display_changed (LCD.c; also set by lcd_4line /
+//              lcd_BIG_mid) still works and marks all four lines.
+//
+//              LCD.c sends in the background; a tick that finds the
+//              previous refresh still on the wire (lcd_frame_done == 0)
+//              is held over, and its changes go out with the next one.
+//
 // Author: Thomas Gilbert
 //==============================================================================
 #include "msp430.h"
@@ -9,17 +25,117 @@
 #include "ports.h"
 #include "macros.h"
 
+extern char display_line[4][11];
 extern volatile unsigned char display_changed;
 extern volatile unsigned char update_display;
 
+static const char display_home[LCD_LINES] = {
+    LCD_HOME_L1, LCD_HOME_L2, LCD_HOME_L3, LCD_HOME_L4
+};
 
+static char          display_shown[LCD_LINES][LCD_COLS];
+static unsigned char display_dirty = 0;             // LCD_LINE_BIT mask
+static unsigned char display_stale = LCD_ALL_LINES; // display_shown unknown
+
+//------------------------------------------------------------------------------
+// display_flush_line -- send the changed span of one line.  lcd_out writes
+// from (home + position) until the string's NUL, so the span is copied out
+// and terminated.  Cells past a short line's NUL are left alone on the
+// glass, same as Display_Update.
+//------------------------------------------------------------------------------
+static void display_flush_line(unsigned char line){
+    const char   *now   = display_line[line];
+    char         *shown = display_shown[line];
+    unsigned char stale = display_stale & LCD_LINE_BIT(line);
+    unsigned char first = LCD_COLS;
+    unsigned char last  = 0;
+    unsigned char i;
+    char          run[LCD_COLS + 1];
+
+    for(i = 0; i < LCD_COLS && now[i] != '\0'; i++){
+        if(stale || now[i] != shown[i]){
+            if(first == LCD_COLS){
+                first = i;
+            }
+            last     = i;
+            shown[i] = now[i];
+        }
+    }
+    if(stale){
+        for(; i < LCD_COLS; i++){
+            shown[i] = '\0';                // never matches a printable cell
+        }
+        display_stale &= (unsigned char)~LCD_LINE_BIT(line);
+    }
+    if(first == LCD_COLS){
+        return;
+    }
+
+    for(i = first; i <= last; i++){
+        run[i - first] = now[i];
+    }
+    run[last - first + 1] = '\0';
+    lcd_out(run, display_home[line], (char)first);
+}
+
+//==============================================================================
+// Display_Line -- copy text (padded / cut to LCD_COLS) into display_line[line]
+// and mark it if anything changed.
+//==============================================================================
+void Display_Line(unsigned char line, const char *text){
+    char         *dst;
+    unsigned char i;
+    char          c;
+
+    if(line >= LCD_LINES){
+        return;
+    }
+    dst = display_line[line];
+    for(i = 0; i < LCD_COLS; i++){
+        c = (*text != '\0') ? *text++ : ' ';
+        if(dst[i] != c){
+            dst[i] = c;
+            display_dirty |= LCD_LINE_BIT(line);
+        }
+    }
+    dst[LCD_COLS] = '\0';
+}
+
+//==============================================================================
+// Display_Mark -- display_line[] edited in place; mask is LCD_LINE_BIT(n)s.
+//==============================================================================
+void Display_Mark(unsigned char mask){
+    display_dirty |= mask & LCD_ALL_LINES;
+}
+
+//==============================================================================
+// Display_Invalidate -- glass contents unknown (after Init_LCD) or a new
+// screen (Display_Network_Info): the next refresh rewrites every cell.
+//==============================================================================
+void Display_Invalidate(void){
+    display_stale = LCD_ALL_LINES;
+    display_dirty = LCD_ALL_LINES;
+}
+
+//==============================================================================
+// Display_Process -- main loop.  Flushes the marked lines once per
+// update_display tick, once the LCD has finished the last flush.
+//==============================================================================
 void Display_Process(void){
-  if(update_display){
+    unsigned char line;
+
+    if(!update_display || !lcd_frame_done){
+        return;
+    }
     update_display = 0;
     if(display_changed){
-      display_changed = 0;
-      Display_Update(0,0,0,0);
+        display_changed = 0;
+        display_dirty  |= LCD_ALL_LINES;
+    }
+    for(line = 0; line < LCD_LINES && display_dirty; line++){
+        if(display_dirty & LCD_LINE_BIT(line)){
+            display_dirty &= (unsigned char)~LCD_LINE_BIT(line);
+            display_flush_line(line);
+        }
     }
-  }
 }
-
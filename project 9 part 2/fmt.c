@@ -0,0 +1,209 @@
+//==============================================================================
+// File:        fmt.c
+// Description: Division-free number formatting (see fmt.h).
+//
+//              The MSP430FR2355 has a multiplier but no divider, so every
+//              "/ 10" or "% 10" is a call into the compiler's software
+//              divide.  Here each decimal digit is found by subtracting
+//              its power of ten until the remainder is smaller -- at most
+//              nine compare/subtract pairs per digit, all in registers --
+//              and hex is plain shifts.  Fmt_Dec with FMT_ZERO and a width
+//              (the LCD fields and TX templates) writes each digit as it
+//              is found and skips the pad/sign layout pass.
+//
+//              NProject 9 has the same fmt.c -- change both together.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "fmt.h"
+
+#define FMT_DIGITS16        (5)     // 65535
+#define FMT_DIGITS32        (10)    // 4294967295
+
+static const unsigned int fmt_pow16[FMT_DIGITS16 - 1] = {
+    10000u, 1000u, 100u, 10u
+};
+
+static const unsigned long fmt_pow32[FMT_DIGITS32 - 1] = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+    10000UL, 1000UL, 100UL, 10UL
+};
+
+static const char fmt_hex[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+//------------------------------------------------------------------------------
+// fmt_digits16 / fmt_digits32 -- value as decimal digits (0-9), most
+// significant first.
+//------------------------------------------------------------------------------
+static void fmt_digits16(unsigned char *d, unsigned int value){
+    unsigned char i;
+    unsigned char n;
+    unsigned int  p;
+
+    for(i = 0; i < FMT_DIGITS16 - 1; i++){
+        p = fmt_pow16[i];
+        n = 0;
+        while(value >= p){
+            value -= p;
+            n++;
+        }
+        d[i] = n;
+    }
+    d[FMT_DIGITS16 - 1] = (unsigned char)value;
+}
+
+static void fmt_digits32(unsigned char *d, unsigned long value){
+    unsigned char i;
+    unsigned char n;
+    unsigned long p;
+
+    for(i = 0; i < FMT_DIGITS32 - 1; i++){
+        p = fmt_pow32[i];
+        n = 0;
+        while(value >= p){
+            value -= p;
+            n++;
+        }
+        d[i] = n;
+    }
+    d[FMT_DIGITS32 - 1] = (unsigned char)value;
+}
+
+//------------------------------------------------------------------------------
+// fmt_zero16 -- the low width (1-5) digits of value, zero padded.  With no
+// pad or sign to place, each digit goes to dst as soon as it is found.
+//------------------------------------------------------------------------------
+static char *fmt_zero16(char *dst, unsigned int value, unsigned char width){
+    unsigned char i;
+    unsigned int  p;
+    char          c;
+
+    for(i = 0; i < FMT_DIGITS16 - 1; i++){
+        p = fmt_pow16[i];
+        c = '0';
+        while(value >= p){
+            value -= p;
+            c++;
+        }
+        if(i + width >= FMT_DIGITS16){
+            *dst++ = c;
+        }
+    }
+    *dst++ = (char)('0' + value);
+    return dst;
+}
+
+//------------------------------------------------------------------------------
+// fmt_emit -- lay out n digits into width cells.  Digits left of the first
+// significant one (but never the units digit, or any of the frac digits
+// after the point) are printed as pad.  A '-' goes in the first cell for
+// zero padding, otherwise just left of the number; if the number fills
+// every cell, the '-' replaces the first one.
+//------------------------------------------------------------------------------
+static char *fmt_emit(char *dst, const unsigned char *d, signed char n,
+                      unsigned char width, char pad, unsigned char neg,
+                      unsigned char frac){
+    char         *start = dst;
+    signed char   sig;
+    signed char   cells;
+    signed char   k;
+    unsigned char signed_done = 0;
+    char          c;
+
+    for(sig = 0; sig < n - 1 - (signed char)frac && d[sig] == 0; sig++);
+
+    cells = (signed char)(n - sig);             // digits that matter
+    if(width != 0){
+        cells = (signed char)width;
+        if(frac){
+            cells--;
+        }
+        if(neg && pad == FMT_ZERO){
+            cells--;
+        }
+    }
+
+    if(neg && (pad == FMT_ZERO || width == 0)){
+        *dst++ = '-';
+        signed_done = 1;
+    }
+    for(k = (signed char)(n - cells); k < n; k++){
+        if(frac && k == n - (signed char)frac){
+            *dst++ = '.';
+        }
+        if(k >= sig){
+            c = (char)('0' + d[k]);
+        } else if(neg && !signed_done && k == sig - 1){
+            c = '-';
+            signed_done = 1;
+        } else {
+            c = pad;
+        }
+        *dst++ = c;
+    }
+    if(neg && !signed_done){
+        *start = '-';
+    }
+    return dst;
+}
+
+//==============================================================================
+// Public
+//==============================================================================
+char *Fmt_Dec(char *dst, unsigned int value, unsigned char width, char pad){
+    unsigned char d[FMT_DIGITS16];
+
+    if(pad == FMT_ZERO && width != 0 && width <= FMT_DIGITS16){
+        return fmt_zero16(dst, value, width);
+    }
+    fmt_digits16(d, value);
+    return fmt_emit(dst, d, FMT_DIGITS16, width, pad, 0, 0);
+}
+
+char *Fmt_Sdec(char *dst, int value, unsigned char width, char pad){
+    unsigned char d[FMT_DIGITS16];
+    unsigned char neg = (value < 0);
+
+    // 0u - value is the magnitude even for -32768
+    fmt_digits16(d, neg ? 0u - (unsigned int)value : (unsigned int)value);
+    return fmt_emit(dst, d, FMT_DIGITS16, width, pad, neg, 0);
+}
+
+char *Fmt_Dec32(char *dst, unsigned long value, unsigned char width, char pad){
+    unsigned char d[FMT_DIGITS32];
+
+    fmt_digits32(d, value);
+    return fmt_emit(dst, d, FMT_DIGITS32, width, pad, 0, 0);
+}
+
+char *Fmt_Fixed(char *dst, unsigned int value, unsigned char frac,
+                unsigned char width, char pad){
+    unsigned char d[FMT_DIGITS16];
+
+    if(frac > FMT_DIGITS16 - 1){
+        frac = FMT_DIGITS16 - 1;
+    }
+    fmt_digits16(d, value);
+    return fmt_emit(dst, d, FMT_DIGITS16, width, pad, 0, frac);
+}
+
+char *Fmt_Hex(char *dst, unsigned int value, unsigned char width){
+    unsigned char shift;
+
+    if(width == 0 || width > 4){
+        width = 4;
+    }
+    shift = (unsigned char)(width * 4);
+    while(shift != 0){
+        shift -= 4;
+        *dst++ = fmt_hex[(value >> shift) & 0x0F];
+    }
+    return dst;
+}
@@ -19,6 +19,8 @@ void enable_interrupts(void);
 // Timer B0 ISRs (interrupts_timers.c)
 __interrupt void Timer0_B0_ISR(void);   // CCR0: 200 ms display update tick
 __interrupt void TIMER0_B1_ISR(void);   // CCR1/CCR2: SW1/SW2 debounce timers
+__interrupt void Timer1_B0_ISR(void);   // CCR0: line-follow control clock
+__interrupt void TIMER2_B1_ISR(void);   // Overflow: cycle counter high word
 
 // Port ISRs (interrupt_ports.c)
 __interrupt void switch1_interrupt(void); // PORT4_VECTOR: SW1 (P4.1) -- transmit
@@ -31,8 +33,13 @@ extern volatile unsigned int sw2_debounce_count;
 // Clocks
 void Init_Clocks(void);
 
-// LCD (from LCD.obj -- Carlson's library)
+// Display (display.c) -- dirty-line tracking in front of LCD.c
 void Display_Process(void);
+void Display_Line(unsigned char line, const char *text);
+void Display_Mark(unsigned char mask);
+void Display_Invalidate(void);
+
+// LCD (LCD.c -- same API as Carlson's LCD.obj)
 void Display_Update(char p_L1, char p_L2, char p_L3, char p_L4);
 void enable_display_update(void);
 void update_string(char *string_data, int string);
@@ -92,6 +99,8 @@ void Switches_Process(void);
 // Timers
 void Init_Timers(void);
 void Init_Timer_B0(void);
+void Init_Timer_B1(void);
+void Init_Timer_B2(void);
 void Init_Timer_B3(void);
 
 // Serial communication (serial.c / serial.h)
@@ -121,7 +130,7 @@ void Vehicle_Cmd_Tick(void);       // Called from Timer B0 CCR0 ISR every 200 ms
 void Process_Vehicle_Queue(void);  // Main loop -- starts next queued cmd
 
 // DAC (dac.c) -- sets up buck-boost motor supply rail
-void Init_DAC(void);
+void Init_DAC(void);           // Rest of the DAC API is in dac.h
 
 // ADC (adc.c)
 void Init_ADC(void);
@@ -132,3 +141,4 @@ void Calibration_Start(void);
 void Calibration_Tick(void);
 void Line_Follow_Start(unsigned int seconds);
 void Line_Follow_Tick(void);
+void Line_Follow_Set_Gain(char which, unsigned int value);
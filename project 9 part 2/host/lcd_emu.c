@@ -0,0 +1,253 @@
+//==============================================================================
+// File:        host/lcd_emu.c
+// Description: SSD1803A model and eUSCI_B1 pump for the simulator (see
+//              lcd_emu.h).
+//
+//              Only what LCD.c uses is modelled: instruction/data frames,
+//              clear, DDRAM address set, the RE/IS/DH function-set bits,
+//              NW (4-line), UD2/UD1 (which line is double height),
+//              BDC/BDS (lcd_180) and display on/off.  CGRAM, contrast and
+//              the booster/follower settings are accepted and ignored.
+//
+//              4-line DDRAM rows start at 0x00 / 0x20 / 0x40 / 0x60
+//              (LCD_HOME_L1..L4 without the 0x80 command bit).  With DH
+//              set, three (or two) DDRAM lines share the four rows:
+//                UD2 UD1  rows 1-4
+//                 0   0   0x00  0x20  0x40  0x40     lcd_BIG_bot
+//                 0   1   0x00  0x20  0x20  0x40     lcd_BIG_mid
+//                 1   0   0x00  0x00  0x20  0x40
+//                 1   1   0x00  0x00  0x20  0x20
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#include <string.h>
+#include "msp430.h"
+#include "macros.h"
+#include "ports.h"
+#include "LCD.h"
+#include "lcd_emu.h"
+
+#define EMU_DDRAM_SIZE      (0x80)
+#define EMU_ROW_STRIDE      (0x20)
+#define EMU_SPI_BYTE_US     (8UL * LCD_SPI_BRW * 1000000UL / SMCLK_HZ)
+
+#define EMU_UD_MASK         (UD2_BIT | UD1_BIT)
+
+//------------------------------------------------------------------------------
+// Controller state
+//------------------------------------------------------------------------------
+static unsigned char emu_ddram[EMU_DDRAM_SIZE];
+static unsigned char emu_ac;                // DDRAM address counter
+static unsigned char emu_re;                // Extended instruction set
+static unsigned char emu_is;                // Special instruction set
+static unsigned char emu_dh;                // Double height enabled
+static unsigned char emu_nw;                // 4-line
+static unsigned char emu_ud;                // UD2 | UD1
+static unsigned char emu_on;                // Display on
+static unsigned char emu_flip;              // BDC clear (lcd_180 BOTTOM)
+
+// Serial framing: start byte, low nibble, high nibble
+static unsigned char emu_frame[3];
+static unsigned char emu_frame_idx;
+
+static lcd_emu_stats_t emu_stats;
+static FILE           *emu_log;
+
+//------------------------------------------------------------------------------
+// emu_row_addr -- DDRAM address shown on physical row (table above).
+//------------------------------------------------------------------------------
+static unsigned char emu_row_addr(unsigned char row){
+    static const unsigned char dh_line[4][LCD_EMU_ROWS] = {
+        { 0, 1, 2, 2 },                             // UD 00
+        { 0, 1, 1, 2 },                             // UD 01
+        { 0, 0, 1, 2 },                             // UD 10
+        { 0, 0, 1, 1 },                             // UD 11
+    };
+    unsigned char line = row;
+
+    if(emu_dh){
+        line = dh_line[emu_ud >> 2][row];
+    }
+    return (unsigned char)(line * EMU_ROW_STRIDE);
+}
+
+//------------------------------------------------------------------------------
+// emu_instruction -- decode by the RE / IS bits in force, as the controller
+// does.  Function set is read in both pages; its bit 2 is DH only with RE
+// clear, and its bit 0 is IS only with RE clear.
+//------------------------------------------------------------------------------
+static void emu_instruction(unsigned char ins){
+    emu_stats.instructions++;
+
+    if(ins & 0x80){                                 // Set DDRAM address
+        emu_ac = (unsigned char)(ins & (EMU_DDRAM_SIZE - 1));
+    } else if((ins & 0xE0) == FUNCTION_SET){
+        emu_re = (ins & RE_BIT) ? 1 : 0;
+        if(!emu_re){
+            emu_dh = (ins & DH_BIT) ? 1 : 0;
+            emu_is = (ins & IS_BIT) ? 1 : 0;
+        }
+    } else if(ins == CLEAR_DISPLAY){
+        memset(emu_ddram, ' ', sizeof(emu_ddram));
+        emu_ac = 0;
+    } else if(emu_re){
+        if((ins & 0xF0) == DH_BIAS_DOT_SHIFT){
+            emu_ud = (unsigned char)(ins & EMU_UD_MASK);
+        } else if((ins & 0xF8) == EXTENDED_FUNCTION_SET){
+            emu_nw = (ins & NW_BIT) ? 1 : 0;
+        } else if((ins & 0xFC) == ENTRY_MODE_SET){
+            emu_flip = (ins & BDC_BIT) ? 0 : 1;     // TOP 0x06 / BOTTOM 0x05
+        }
+    } else if(!emu_is && (ins & 0xFE) == RETURN_HOME){
+        emu_ac = 0;
+    } else if((ins & 0xF8) == DISPLAY_CONTROL){
+        emu_on = (ins & D_BIT) ? 1 : 0;
+    }
+}
+
+static void emu_data(unsigned char c){
+    emu_stats.chars++;
+    if(emu_ddram[emu_ac] == c){
+        emu_stats.chars_same++;
+    }
+    emu_ddram[emu_ac] = c;
+    emu_ac = (unsigned char)((emu_ac + 1) & (EMU_DDRAM_SIZE - 1));
+}
+
+//------------------------------------------------------------------------------
+// emu_spi_byte -- one byte shifted into the controller.  LCD.c drops chip
+// select before every start byte, so a byte with CS high is lost.
+//------------------------------------------------------------------------------
+static void emu_spi_byte(unsigned char b){
+    emu_stats.spi_bytes++;
+    emu_stats.wire_us += EMU_SPI_BYTE_US;
+
+    if(P4OUT & UCB1_CS_LCD){
+        emu_stats.framing_errors++;
+        emu_frame_idx = 0;
+        return;
+    }
+    if(emu_frame_idx == 0 && b != START_WR_INSTRUCTION && b != START_WR_DATA){
+        emu_stats.framing_errors++;
+        return;
+    }
+    emu_frame[emu_frame_idx++] = b;
+    if(emu_frame_idx < 3){
+        return;
+    }
+    emu_frame_idx = 0;
+    b = (unsigned char)((emu_frame[1] & 0x0F) | (emu_frame[2] << 4));
+    if(emu_frame[0] == START_WR_DATA){
+        emu_data(b);
+    } else {
+        emu_instruction(b);
+    }
+}
+
+//==============================================================================
+// Lcd_Emu_Reset
+//==============================================================================
+void Lcd_Emu_Reset(void){
+    memset(emu_ddram, ' ', sizeof(emu_ddram));
+    emu_ac        = 0;
+    emu_re        = 0;
+    emu_is        = 0;
+    emu_dh        = 0;
+    emu_nw        = 0;
+    emu_ud        = 0;
+    emu_on        = 0;
+    emu_flip      = 0;
+    emu_frame_idx = 0;
+    Lcd_Emu_Clear_Stats();
+}
+
+//==============================================================================
+// Lcd_Emu_Screen / Lcd_Emu_Layout -- what the glass shows now.
+//==============================================================================
+void Lcd_Emu_Screen(char rows[LCD_EMU_ROWS][LCD_EMU_COLS + 1]){
+    unsigned char r;
+    unsigned char i;
+    unsigned char a;
+
+    for(r = 0; r < LCD_EMU_ROWS; r++){
+        a = emu_row_addr(r);
+        for(i = 0; i < LCD_EMU_COLS; i++){
+            rows[r][i] = (char)(emu_on ? emu_ddram[a + i] : ' ');
+        }
+        rows[r][LCD_EMU_COLS] = '\0';
+    }
+}
+
+const char *Lcd_Emu_Layout(void){
+    static const char *const big[4] = { "big_bot", "big_mid", "big_top", "big_2" };
+
+    if(!emu_on){
+        return "off";
+    }
+    if(!emu_nw){
+        return "2line";
+    }
+    return emu_dh ? big[emu_ud >> 2] : "4line";
+}
+
+//==============================================================================
+// Lcd_Emu_Pump -- clock out whatever LCD.c has queued, one eUSCI_B1_ISR per
+// byte, and account for it as one refresh at now_ms.
+//==============================================================================
+void Lcd_Emu_Pump(unsigned long now_ms){
+    char          before[LCD_EMU_ROWS][LCD_EMU_COLS + 1];
+    char          after[LCD_EMU_ROWS][LCD_EMU_COLS + 1];
+    const char   *layout = Lcd_Emu_Layout();
+    unsigned char flip   = emu_flip;
+    unsigned long bytes  = emu_stats.spi_bytes;
+    unsigned char same;
+    unsigned char r;
+
+    if(lcd_frame_done){
+        return;
+    }
+    Lcd_Emu_Screen(before);
+    while(!lcd_frame_done){
+        emu_spi_byte((unsigned char)UCB1TXBUF);
+        UCB1IV = 2;                                 // UCRXIFG
+        eUSCI_B1_ISR();
+    }
+    bytes = emu_stats.spi_bytes - bytes;
+
+    Lcd_Emu_Screen(after);
+    same = memcmp(before, after, sizeof(before)) == 0 &&
+           strcmp(layout, Lcd_Emu_Layout()) == 0 && flip == emu_flip;
+    emu_stats.refreshes++;
+    if(same){
+        emu_stats.redundant++;
+    }
+
+    if(emu_log){
+        fprintf(emu_log, "%9lu ms %4lu B %6lu us  %-7s%s", now_ms, bytes,
+                bytes * EMU_SPI_BYTE_US, Lcd_Emu_Layout(),
+                emu_flip ? "/180" : "    ");
+        for(r = 0; r < LCD_EMU_ROWS; r++){
+            fprintf(emu_log, " |%s|", after[r]);
+        }
+        fprintf(emu_log, "%s\n", same ? "  =" : "");
+    }
+}
+
+//==============================================================================
+// Logging and statistics
+//==============================================================================
+void Lcd_Emu_Log(FILE *f){
+    emu_log = f;
+}
+
+void Lcd_Emu_Stats(lcd_emu_stats_t *s){
+    *s = emu_stats;
+}
+
+void Lcd_Emu_Clear_Stats(void){
+    memset(&emu_stats, 0, sizeof(emu_stats));
+}
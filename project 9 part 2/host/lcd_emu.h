@@ -0,0 +1,56 @@
+//==============================================================================
+// File:        host/lcd_emu.h
+// Description: Host model of the DOGS104 / SSD1803A LCD behind eUSCI_B1.
+//
+//              The real LCD.c and display.c are linked into the simulator.
+//              Lcd_Emu_Pump stands in for the SPI peripheral: it runs
+//              eUSCI_B1_ISR once per byte until LCD.c's queue drains, and
+//              feeds every byte on the wire to a controller model (DDRAM,
+//              address counter, function-set / double-height state).  The
+//              glass is read back as four physical rows, so BIG_mid and
+//              BIG_bot show the double-height line on two rows exactly as
+//              the car does.
+//
+//              One pump that moves any bytes is one refresh.  Each refresh
+//              can be written to a log with its timestamp, byte count and
+//              the glass after it; a refresh that leaves the glass as it
+//              was is counted as redundant.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#ifndef LCD_EMU_H_
+#define LCD_EMU_H_
+
+#include <stdio.h>
+
+#define LCD_EMU_ROWS        (4)
+#define LCD_EMU_COLS        (10)
+
+typedef struct {
+    unsigned long refreshes;        // Pumps that moved at least one byte
+    unsigned long redundant;        // ... and left the glass unchanged
+    unsigned long spi_bytes;        // Every byte on the wire (3 per write)
+    unsigned long instructions;
+    unsigned long chars;            // Data writes
+    unsigned long chars_same;       // Data writes of the char already there
+    unsigned long wire_us;          // SPI time at LCD_SPI_BRW
+    unsigned long framing_errors;   // Bad start byte or chip select high
+} lcd_emu_stats_t;
+
+void Lcd_Emu_Reset(void);           // Power-on controller, stats cleared
+void Lcd_Emu_Pump(unsigned long now_ms);
+void Lcd_Emu_Log(FILE *f);          // NULL stops logging
+
+void Lcd_Emu_Stats(lcd_emu_stats_t *s);
+void Lcd_Emu_Clear_Stats(void);
+
+// Glass as LCD_EMU_ROWS NUL-terminated rows, and the layout name
+// ("4line", "big_mid", "big_bot", "big_top", "big_2", "2line", "off").
+void        Lcd_Emu_Screen(char rows[LCD_EMU_ROWS][LCD_EMU_COLS + 1]);
+const char *Lcd_Emu_Layout(void);
+
+#endif /* LCD_EMU_H_ */
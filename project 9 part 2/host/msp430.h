@@ -0,0 +1,137 @@
+//==============================================================================
+// File:        host/msp430.h
+// Description: Host (Linux/gcc) stand-in for TI's msp430.h, used only by the
+//              line-follow simulator.  Every peripheral register the firmware
+//              touches is a plain global (defined once in sim_hw.c through
+//              the SIM_REGS list below), so firmware writes to TB3CCRx land
+//              somewhere the car model can read them and the simulator can
+//              load ADCMEM0 before calling ADC_ISR() by hand (and
+//              lcd_emu.c can read UCB1TXBUF before calling eUSCI_B1_ISR()).
+//
+//              Bit constants carry their real FR2355 values where the
+//              firmware does arithmetic on them (ADCINCH_x, ADCIV_x, TBIE).
+//
+//              NOTE: int is 32 bits here, 16 bits on the target.  The
+//              control path does its wide math in long, so results match,
+//              but keep that in mind when adding new firmware code to the
+//              simulator build.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#ifndef HOST_MSP430_H_
+#define HOST_MSP430_H_
+
+//------------------------------------------------------------------------------
+// Compiler intrinsics -- no-ops on the host
+//------------------------------------------------------------------------------
+#define __interrupt
+#define __even_in_range(x, y)       (x)
+#define __bis_SR_register(x)        ((void)0)
+#define __bic_SR_register(x)        ((void)0)
+#define __delay_cycles(x)           ((void)0)
+#define __no_operation()            ((void)0)
+#define __disable_interrupt()       ((void)0)
+#define __enable_interrupt()        ((void)0)
+#define __get_interrupt_state()     (0u)
+#define __set_interrupt_state(x)    ((void)(x))
+
+//------------------------------------------------------------------------------
+// Register list.  R16 = 16-bit register, R8 = 8-bit port register.
+//------------------------------------------------------------------------------
+#define SIM_REGS(R16, R8)                                                     \
+    R16(TB0CTL)   R16(TB0R)     R16(TB0CCR0)  R16(TB0CCR1)  R16(TB0CCR2)      \
+    R16(TB0CCTL0) R16(TB0CCTL1) R16(TB0CCTL2) R16(TB0IV)    R16(TB0EX0)       \
+    R16(TB1CTL)   R16(TB1R)     R16(TB1CCR0)  R16(TB1CCTL0)                   \
+    R16(TB2CTL)   R16(TB2R)                                                   \
+    R16(TB3CTL)   R16(TB3R)     R16(TB3CCR0)  R16(TB3CCR1)  R16(TB3CCR2)      \
+    R16(TB3CCR3)  R16(TB3CCR4)  R16(TB3CCR5)  R16(TB3CCR6)  R16(TB3CCTL0)     \
+    R16(TB3CCTL1) R16(TB3CCTL2) R16(TB3CCTL3) R16(TB3CCTL4) R16(TB3CCTL5)     \
+    R16(TB3IV)                                                                \
+    R16(ADCCTL0)  R16(ADCCTL1)  R16(ADCCTL2)  R16(ADCMCTL0) R16(ADCMEM0)      \
+    R16(ADCIE)    R16(ADCIFG)   R16(ADCIV)                                    \
+    R16(SAC3DAT)                                                              \
+    R16(SYSCFG0)  R16(SYSRSTIV)                                               \
+    R16(UCB1CTLW0) R16(UCB1BRW) R16(UCB1TXBUF) R16(UCB1RXBUF) R16(UCB1IE)     \
+    R16(UCB1IFG)  R16(UCB1IV)                                                 \
+    R8(P1OUT) R8(P1DIR) R8(P1SEL0) R8(P1SEL1) R8(P1IN) R8(P1IE) R8(P1IFG)     \
+    R8(P2OUT) R8(P2DIR) R8(P2SEL0) R8(P2SEL1) R8(P2IN) R8(P2IE) R8(P2IFG)     \
+    R8(P3OUT) R8(P3DIR) R8(P3SEL0) R8(P3SEL1) R8(P3IN)                        \
+    R8(P4OUT) R8(P4DIR) R8(P4SEL0) R8(P4SEL1) R8(P4IN) R8(P4IE) R8(P4IFG)     \
+    R8(P5OUT) R8(P5DIR) R8(P5SEL0) R8(P5SEL1) R8(P5IN)                        \
+    R8(P6OUT) R8(P6DIR) R8(P6SEL0) R8(P6SEL1) R8(P6IN)
+
+#define SIM_DECL16(n)   extern volatile unsigned int  n;
+#define SIM_DECL8(n)    extern volatile unsigned char n;
+SIM_REGS(SIM_DECL16, SIM_DECL8)
+
+//------------------------------------------------------------------------------
+// Bit constants
+//------------------------------------------------------------------------------
+#define BIT0            (0x0001)
+#define BIT1            (0x0002)
+#define BIT2            (0x0004)
+#define BIT3            (0x0008)
+#define BIT4            (0x0010)
+#define BIT5            (0x0020)
+#define BIT6            (0x0040)
+#define BIT7            (0x0080)
+
+// Timer_B
+#define TBIFG           (0x0001)
+#define TBIE            (0x0002)
+#define TBCLR           (0x0004)
+#define CCIFG           (0x0001)
+#define CCIE            (0x0010)
+#define OUTMOD_7        (0x00E0)
+#define CLLD_1          (0x0200)
+#define MC__UP          (0x0010)
+#define MC__CONTINUOUS  (0x0020)
+#define TBSSEL__SMCLK   (0x0200)
+
+// ADC
+#define ADCSC           (0x0001)
+#define ADCENC          (0x0002)
+#define ADCON           (0x0010)
+#define ADCMSC          (0x0080)
+#define ADCSHT_2        (0x0200)
+#define ADCSHP          (0x0200)
+#define ADCSHS_0        (0x0000)
+#define ADCRES_2        (0x0020)
+#define ADCSREF_0       (0x0000)
+#define ADCIE0          (0x0001)
+#define ADCINCH_2       (0x0002)
+#define ADCINCH_3       (0x0003)
+#define ADCINCH_5       (0x0005)
+#define ADCINCH_10      (0x000A)
+#define ADCINCH_15      (0x000F)
+#define ADCIV_NONE      (0x0000)
+#define ADCIV_ADCIFG    (0x000C)
+
+// FRAM write protection (SYSCFG0)
+#define FRWPPW          (0xA500)
+#define PFWP            (0x0001)
+#define DFWP            (0x0002)
+
+// eUSCI_B
+#define UCSWRST         (0x0001)
+#define UCSSEL__SMCLK   (0x0080)
+#define UCSYNC          (0x0100)
+#define UCMST           (0x0800)
+#define UCMSB           (0x2000)
+#define UCCKPL          (0x4000)
+#define UCRXIE          (0x0001)
+#define UCTXIE          (0x0002)
+
+// Interrupt vectors (only used inside #pragma vector, ignored by gcc)
+#define TIMER0_B0_VECTOR    (0)
+#define TIMER0_B1_VECTOR    (0)
+#define TIMER1_B0_VECTOR    (0)
+#define TIMER3_B0_VECTOR    (0)
+#define ADC_VECTOR          (0)
+#define EUSCI_B1_VECTOR     (0)
+
+#endif /* HOST_MSP430_H_ */
@@ -0,0 +1,233 @@
+//==============================================================================
+// File:        host/rammap.c
+// Description: Static RAM budget from the CCS linker map.
+//
+//   Reads the .map file the TI linker writes next to the .out (Debug/ by
+//   default) and prints:
+//     - rw data per module, largest first, from the MODULE SUMMARY table
+//       (this is what each .obj / library member puts in .bss, .data and
+//       .TI.noinit, tentative definitions included)
+//     - the stack size and the RAM used / unused from MEMORY CONFIGURATION
+//   With -s it also lists every input section placed in .bss, .data and
+//   .TI.noinit (SECTION ALLOCATION MAP), largest first -- that is where
+//   IOT_Data, the rings and cmd_queue show up by name.
+//
+//   The firmware reports the stack's high-water mark at run time (^M,
+//   stackmon.c); stack size minus that is the stack headroom, the unused
+//   RAM below is what is left for new buffers.
+//
+// Usage: rammap [-s] file.map
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define LINE_LEN        (512)
+#define MAX_ENTRIES     (256)
+#define NAME_LEN        (96)
+
+typedef struct {
+    char          name[NAME_LEN];
+    unsigned long bytes;
+} entry_t;
+
+static entry_t       modules[MAX_ENTRIES];
+static int           n_modules;
+static entry_t       sections[MAX_ENTRIES];
+static int           n_sections;
+static unsigned long stack_bytes;
+static unsigned long ram_length;
+static unsigned long ram_used;
+static int           have_summary;
+static int           have_memory;
+
+static void add(entry_t *list, int *n, const char *name, unsigned long bytes){
+    int i;
+
+    for(i = 0; i < *n; i++){
+        if(strcmp(list[i].name, name) == 0){
+            list[i].bytes += bytes;
+            return;
+        }
+    }
+    if(*n < MAX_ENTRIES){
+        snprintf(list[*n].name, NAME_LEN, "%s", name);
+        list[*n].bytes = bytes;
+        (*n)++;
+    }
+}
+
+static int by_size(const void *a, const void *b){
+    const entry_t *x = a;
+    const entry_t *y = b;
+
+    return (x->bytes < y->bytes) - (x->bytes > y->bytes);
+}
+
+//------------------------------------------------------------------------------
+// MEMORY CONFIGURATION row:  RAM  origin  length  used  unused  attr
+//------------------------------------------------------------------------------
+static void parse_memory(const char *line){
+    char          name[32];
+    unsigned long origin, length, used;
+
+    if(sscanf(line, "%31s %lx %lx %lx", name, &origin, &length, &used) == 4
+       && strcmp(name, "RAM") == 0){
+        ram_length  = length;
+        ram_used    = used;
+        have_memory = 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+// MODULE SUMMARY row:  name  code  ro-data  rw-data
+// The name may contain spaces ("Linker Generated:"), so the three numbers
+// are taken from the end of the line.
+//------------------------------------------------------------------------------
+static void parse_summary(const char *line){
+    char          name[NAME_LEN];
+    const char   *end = line + strlen(line);
+    const char   *p   = end;
+    unsigned long num[3];
+    int           k;
+    size_t        len;
+
+    for(k = 2; k >= 0; k--){
+        while(p > line && isspace((unsigned char)p[-1])) p--;
+        end = p;
+        while(p > line && isdigit((unsigned char)p[-1])) p--;
+        if(p == end) return;
+        num[k] = strtoul(p, NULL, 10);
+    }
+    while(line < p && isspace((unsigned char)*line)) line++;
+    while(p > line && isspace((unsigned char)p[-1])) p--;
+    len = (size_t)(p - line);
+    if(len == 0 || len >= NAME_LEN) return;
+    memcpy(name, line, len);
+    name[len] = '\0';
+
+    if(strncmp(name, "Total", 5) == 0 || strncmp(name, "Grand Total", 11) == 0){
+        return;
+    }
+    if(strcmp(name, "Stack:") == 0){
+        stack_bytes = num[2];
+        return;
+    }
+    if(num[2] != 0){
+        add(modules, &n_modules, name, num[2]);
+    }
+    have_summary = 1;
+}
+
+//------------------------------------------------------------------------------
+// SECTION ALLOCATION MAP: an output section line starts in column 0
+// (".bss  0  00002000  00000320 ..."); its input sections follow indented
+// ("  00002000  00000240  (.common:IOT_Data)").
+//------------------------------------------------------------------------------
+static void parse_section(const char *line, int *in_ram){
+    char          out[32];
+    char          name[NAME_LEN];
+    unsigned long origin, length;
+    int           used;
+    size_t        len;
+
+    if(line[0] == '\0'){
+        return;
+    }
+    if(!isspace((unsigned char)line[0])){
+        *in_ram = sscanf(line, "%31s", out) == 1
+               && (strcmp(out, ".bss") == 0 || strcmp(out, ".data") == 0
+                   || strcmp(out, ".TI.noinit") == 0);
+        return;
+    }
+    if(*in_ram && sscanf(line, " %lx %lx %n", &origin, &length, &used) >= 2
+       && length != 0){
+        snprintf(name, NAME_LEN, "%s", line + used);
+        len = strlen(name);
+        while(len && isspace((unsigned char)name[len - 1])) name[--len] = '\0';
+        add(sections, &n_sections, name, length);
+    }
+}
+
+int main(int argc, char **argv){
+    enum { NONE, MEMORY, SUMMARY, SECTIONS } where = NONE;
+    char          line[LINE_LEN];
+    int           list_sections = 0;
+    int           in_ram = 0;
+    int           i;
+    unsigned long total = 0;
+    FILE         *f;
+
+    if(argc == 3 && strcmp(argv[1], "-s") == 0){
+        list_sections = 1;
+        argv++;
+        argc--;
+    }
+    if(argc != 2){
+        fprintf(stderr, "usage: rammap [-s] file.map\n");
+        return 2;
+    }
+    f = fopen(argv[1], "r");
+    if(!f){
+        perror(argv[1]);
+        return 1;
+    }
+
+    while(fgets(line, sizeof line, f)){
+        line[strcspn(line, "\r\n")] = '\0';
+        if(strncmp(line, "MEMORY CONFIGURATION", 20) == 0)   { where = MEMORY;   continue; }
+        if(strncmp(line, "MODULE SUMMARY", 14) == 0)         { where = SUMMARY;  continue; }
+        if(strncmp(line, "SECTION ALLOCATION MAP", 22) == 0) { where = SECTIONS; continue; }
+        if(strncmp(line, "LINKER GENERATED", 16) == 0
+           || strncmp(line, "GLOBAL SYMBOLS", 14) == 0
+           || strncmp(line, "SEGMENT ALLOCATION MAP", 22) == 0){
+            where = NONE;
+            continue;
+        }
+        switch(where){
+            case MEMORY:   parse_memory(line);              break;
+            case SUMMARY:  parse_summary(line);             break;
+            case SECTIONS: parse_section(line, &in_ram);    break;
+            default:                                        break;
+        }
+    }
+    fclose(f);
+
+    if(!have_summary && n_sections == 0){
+        fprintf(stderr, "%s: no MODULE SUMMARY or RAM sections found\n", argv[1]);
+        return 1;
+    }
+
+    if(have_summary){
+        qsort(modules, n_modules, sizeof modules[0], by_size);
+        printf("static RAM by module (rw data, bytes)\n");
+        for(i = 0; i < n_modules; i++){
+            printf("  %6lu  %s\n", modules[i].bytes, modules[i].name);
+            total += modules[i].bytes;
+        }
+        printf("  ------\n  %6lu  total static\n", total);
+    }
+    if(list_sections || !have_summary){
+        qsort(sections, n_sections, sizeof sections[0], by_size);
+        printf("\nRAM input sections (.bss/.data/.TI.noinit, bytes)\n");
+        for(i = 0; i < n_sections; i++){
+            printf("  %6lu  %s\n", sections[i].bytes, sections[i].name);
+        }
+    }
+    printf("\n");
+    if(stack_bytes){
+        printf("  %6lu  stack (--stack_size); headroom = this - ^M hwm\n", stack_bytes);
+    }
+    if(have_memory){
+        printf("  %6lu  RAM used of %lu\n", ram_used, ram_length);
+        printf("  %6lu  RAM unused\n", ram_length - ram_used);
+    }
+    return 0;
+}
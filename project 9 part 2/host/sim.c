@@ -0,0 +1,597 @@
+//==============================================================================
+// File:        host/sim.c
+// Description: Closed-loop car + track simulator for tuning line-follow.
+//
+//   The real modes.c / wheels.c / motor.c / pid.c / adc.c are compiled for
+//   the host (see msp430.h and sim_hw.c) and run unchanged.  Each simulated step:
+//
+//     1. Decode wheel drive from the TB3 CCRs the firmware wrote, using the
+//        car's empirical H-bridge wiring (ports.h: CCR1 dead, CCR5 only
+//        while P6.5 is TB3.5).
+//     2. PWM -> wheel speed: deadband, linear above it, first-order lag.
+//     3. Differential-drive kinematics update the pose.
+//     4. On each Timer B1 control tick (LF_CTRL_HZ) the two IR sensors
+//        sample the track bitmap (spot-averaged, noisy) and are fed through
+//        the real ADC_Start_Sweep / ADC_ISR as one A2/A3/A5/A10 sweep.
+//     5. One main-loop pass of Line_Follow_Tick(), then Display_Process()
+//        with the real LCD.c clocking into the SSD1803A model (lcd_emu.c).
+//     Every 200 ms of simulated time the Timer B0 tick advances
+//     Time_Sequence and the ^N countdown, exactly as on the car.
+//
+//   Calibration is also the real state machine: the car is placed on the
+//   floor, then on the tape, and SW1 is "pressed" for each.
+//
+//   Batch mode runs many ^N episodes from slightly randomised start poses
+//   and reports lap time, cross-track error and line-loss count.
+//
+// Usage: linesim [options]
+//   -n episodes     number of ^N runs (default 100)
+//   -t seconds      length of each run, 1..65 (default 60)
+//   -p/-i/-d q8     Kp/Ki/Kd in Q8.8, applied with Line_Follow_Set_Gain
+//   -f hz           physics step rate, a multiple of LF_CTRL_HZ (default 1000)
+//   -m track.pgm    load a track bitmap instead of the built-in oval
+//   -s mm           bitmap scale in mm per pixel (default 2)
+//   -x/-y/-a        start pose for -m tracks: metres, metres, degrees
+//   -w out.pgm      write the built-in oval to a PGM and exit
+//   -D frac         motor deadband as a duty fraction (default 0.15)
+//   -V m/s          wheel speed at 100 % duty (default 0.60)
+//   -N counts       ADC noise amplitude (default 15)
+//   -S seed         random seed (default 1)
+//   -c out.csv      per-episode results
+//   -T out.csv      10 ms pose/sensor/CCR trace of the first episode
+//   -L out.txt      every LCD refresh: time, bytes, layout, the four rows
+//   -R out.txt      ^T trace dump after the first episode (host/tracedec)
+//   -v              echo firmware USB text
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "msp430.h"
+#include "macros.h"
+#include "adc.h"
+#include "modes.h"
+#include "trace.h"
+#include "sim_hw.h"
+#include "track.h"
+#include "lcd_emu.h"
+
+//------------------------------------------------------------------------------
+// Car geometry and drivetrain defaults (measured off the car, rounded)
+//------------------------------------------------------------------------------
+#define CAR_WHEEL_TRACK     (0.140)     // m between wheel contact patches
+#define CAR_SENSOR_AHEAD    (0.090)     // m from axle centre to IR pair
+#define CAR_SENSOR_GAP      (0.012)     // m between left and right IR
+#define CAR_SENSOR_SPOT     (0.004)     // m radius seen by one IR
+#define CAR_MOTOR_TAU       (0.080)     // s wheel speed time constant
+
+#define ADC_FLOOR           (150)       // Counts over white floor
+#define ADC_TAPE            (900)       // Counts over black tape
+#define ADC_THUMB_IDLE      (2048)
+
+#define OVAL_STRAIGHT       (1.00)      // m
+#define OVAL_RADIUS         (0.35)      // m
+#define TAPE_WIDTH          (0.019)     // m (3/4" electrical tape)
+
+#define START_JITTER_POS    (0.008)     // m, +/- lateral start error
+#define START_JITTER_HDG    (10.0)      // deg, +/- heading start error
+#define DERAIL_DISTANCE     (0.30)      // m off the line -> run abandoned
+#define LOSS_MIN_TIME       (0.050)     // s both-off before it counts as lost
+#define TRACE_PERIOD        (0.010)     // s between -T rows
+
+#define TWO_PI              (6.28318530717958648)
+
+//------------------------------------------------------------------------------
+// Options
+//------------------------------------------------------------------------------
+static int         opt_episodes = 100;
+static int         opt_seconds  = 60;
+static int         opt_kp       = LF_PID_KP_Q8;
+static int         opt_ki       = LF_PID_KI_Q8;
+static int         opt_kd       = LF_PID_KD_Q8;
+static int         opt_rate_hz  = 1000;
+static double      opt_deadband = 0.15;
+static double      opt_vmax     = 0.60;
+static int         opt_noise    = 15;
+static unsigned    opt_seed     = 1;
+static const char *opt_csv      = NULL;
+static FILE       *trace        = NULL;
+static FILE       *lcd_log      = NULL;
+
+//------------------------------------------------------------------------------
+// Car state
+//------------------------------------------------------------------------------
+typedef struct {
+    double x, y, hdg;               // Pose: m, m, rad
+    double vl, vr;                  // Wheel surface speeds, m/s
+} car_t;
+
+//------------------------------------------------------------------------------
+// Per-episode results
+//------------------------------------------------------------------------------
+typedef struct {
+    int    laps;
+    double lap_sum;                 // s, total over completed laps
+    double lap_min;
+    double lap_max;
+    double xte_sq_sum;              // m^2, for RMS
+    double xte_max;                 // m
+    long   samples;
+    int    line_loss;
+    int    derailed;
+    unsigned int missed;            // lf_missed_periods at end of run
+    unsigned int recoveries;        // lf_recoveries / lf_recovery_fails
+    unsigned int rec_fails;
+    unsigned long rec_ms;           // lf_recovery_ms_sum
+} result_t;
+
+static unsigned int rng_state = 1;
+
+static double rng_uniform(void){                  // [0, 1)
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return (rng_state >> 8) * (1.0 / 16777216.0);
+}
+
+static int adc_noise(void){                       // ~triangular, +/- opt_noise
+    return (int)((rng_uniform() - rng_uniform()) * opt_noise);
+}
+
+//==============================================================================
+// IR sensor model: average tape coverage over a small spot, mapped onto the
+// floor..tape ADC span, plus noise.
+//==============================================================================
+static unsigned int ir_sample(const track_t *t, double x, double y){
+    double r   = CAR_SENSOR_SPOT * 0.7;
+    double ink = (Track_Ink(t, x, y) * 2.0
+                + Track_Ink(t, x + r, y) + Track_Ink(t, x - r, y)
+                + Track_Ink(t, x, y + r) + Track_Ink(t, x, y - r)) / 6.0;
+    int    adc = ADC_FLOOR + (int)((ADC_TAPE - ADC_FLOOR) * ink) + adc_noise();
+
+    if(adc < 0)    adc = 0;
+    if(adc > 4095) adc = 4095;
+    return (unsigned int)adc;
+}
+
+static void sensor_points(const car_t *c, double *lx, double *ly,
+                          double *rx, double *ry){
+    double fx = c->x + CAR_SENSOR_AHEAD * cos(c->hdg);
+    double fy = c->y + CAR_SENSOR_AHEAD * sin(c->hdg);
+    double ox = -sin(c->hdg) * CAR_SENSOR_GAP / 2.0;    // unit left * half gap
+    double oy =  cos(c->hdg) * CAR_SENSOR_GAP / 2.0;
+
+    *lx = fx + ox;  *ly = fy + oy;
+    *rx = fx - ox;  *ry = fy - oy;
+}
+
+static void feed_sensors(const track_t *t, const car_t *c){
+    double lx, ly, rx, ry;
+
+    sensor_points(c, &lx, &ly, &rx, &ry);
+    Sim_Control_Tick(ir_sample(t, lx, ly), ir_sample(t, rx, ry), ADC_THUMB_IDLE);
+}
+
+//------------------------------------------------------------------------------
+// Hardware timers as seen from one physics step: Timer B1 control tick every
+// ctrl_div steps, Timer B0 200 ms tick every tick_div steps.
+//------------------------------------------------------------------------------
+static int ctrl_div   = 1;
+static int tick_div   = 1;
+static int ctrl_phase = 0;
+static int tick_phase = 0;
+static unsigned long sim_steps = 0;             // Since power-on, all phases
+
+static void run_timers(const track_t *t, const car_t *c){
+    sim_steps++;
+    Sim_Set_Cycles(sim_steps * (TRACE_HZ / (unsigned long)opt_rate_hz));
+    if(++ctrl_phase >= ctrl_div){
+        ctrl_phase = 0;
+        feed_sensors(t, c);
+    }
+    if(++tick_phase >= tick_div){
+        tick_phase = 0;
+        Sim_Timer_Tick();
+    }
+}
+
+// End of a main-loop pass: the display refresh, stamped with simulated time.
+static void run_display(void){
+    Sim_Display_Tick(sim_steps * 1000UL / (unsigned long)opt_rate_hz);
+}
+
+//==============================================================================
+// Drivetrain: signed PWM counts -> target speed (deadband, then linear), then
+// a first-order lag toward it.
+//==============================================================================
+static double pwm_to_speed(int pwm){
+    double duty = (double)abs(pwm) / WHEEL_PERIOD_VAL;
+    double v;
+
+    if(duty <= opt_deadband){
+        return 0.0;
+    }
+    if(duty > 1.0){
+        duty = 1.0;
+    }
+    v = opt_vmax * (duty - opt_deadband) / (1.0 - opt_deadband);
+    return pwm < 0 ? -v : v;
+}
+
+static void car_step(car_t *c, double dt){
+    double a = dt / (CAR_MOTOR_TAU + dt);
+    double v, w;
+
+    c->vl += (pwm_to_speed(Sim_Left_Drive())  - c->vl) * a;
+    c->vr += (pwm_to_speed(Sim_Right_Drive()) - c->vr) * a;
+
+    v = (c->vl + c->vr) / 2.0;
+    w = (c->vr - c->vl) / CAR_WHEEL_TRACK;
+    c->x   += v * cos(c->hdg + w * dt / 2.0) * dt;
+    c->y   += v * sin(c->hdg + w * dt / 2.0) * dt;
+    c->hdg += w * dt;
+}
+
+//==============================================================================
+// Run the firmware for `seconds` of simulated time with the car held still
+// (used while calibrating).
+//==============================================================================
+static void idle_firmware(const track_t *t, car_t *c, double seconds){
+    int steps = (int)(seconds * opt_rate_hz);
+    int i;
+
+    for(i = 0; i < steps; i++){
+        run_timers(t, c);
+        Calibration_Tick();
+        run_display();
+    }
+}
+
+//==============================================================================
+// calibrate -- drive the real ^C state machine: floor under the sensors,
+// SW1, tape under the sensors, SW1.
+//==============================================================================
+static int calibrate(const track_t *t){
+    car_t c;
+
+    memset(&c, 0, sizeof(c));
+    c.x   = t->start_x;
+    c.y   = t->start_y - 0.10;       // 10 cm off the tape = floor
+    c.hdg = t->start_heading;
+    c.x  -= CAR_SENSOR_AHEAD * cos(c.hdg);
+    c.y  -= CAR_SENSOR_AHEAD * sin(c.hdg);
+
+    Calibration_Start();
+    idle_firmware(t, &c, 0.5);
+    sw1_pressed = 1;
+    idle_firmware(t, &c, 1.5);
+
+    c.y += 0.10;                     // sensors centred on the tape
+    idle_firmware(t, &c, 0.5);
+    sw1_pressed = 1;
+    idle_firmware(t, &c, 7.0);       // settle + 5 s "Cal Done" screen
+
+    if(!calibration_done){
+        fprintf(stderr, "calibration did not complete\n");
+        return -1;
+    }
+    printf("calibrated  L white %u black %u thr %u | R white %u black %u thr %u\n",
+           white_left, black_left, threshold_left,
+           white_right, black_right, threshold_right);
+    return 0;
+}
+
+//==============================================================================
+// run_episode -- one ^N<seconds> from a jittered start pose.
+//==============================================================================
+static void run_episode(const track_t *t, result_t *r){
+    car_t  c;
+    double dt        = 1.0 / opt_rate_hz;
+    long   step      = 0;
+    double lat       = (rng_uniform() * 2.0 - 1.0) * START_JITTER_POS;
+    double angle_prev;
+    double angle_sum = 0.0;
+    double lap_start = 0.0;
+    double lost_time = 0.0;
+    int    seen_line = 0;
+    long   trace_div = (long)(TRACE_PERIOD * opt_rate_hz);
+
+    memset(r, 0, sizeof(*r));
+    r->lap_min = 1e9;
+
+    memset(&c, 0, sizeof(c));
+    c.hdg = t->start_heading
+          + (rng_uniform() * 2.0 - 1.0) * START_JITTER_HDG * TWO_PI / 360.0;
+    // Place the car so the sensor pair sits on the tape, shifted sideways.
+    c.x = t->start_x - CAR_SENSOR_AHEAD * cos(c.hdg) - lat * sin(c.hdg);
+    c.y = t->start_y - CAR_SENSOR_AHEAD * sin(c.hdg) + lat * cos(c.hdg);
+    angle_prev = atan2(c.y - t->cy, c.x - t->cx);
+
+    Line_Follow_Set_Gain(CMD_DIR_SET_KP, (unsigned int)opt_kp);
+    Line_Follow_Set_Gain(CMD_DIR_SET_KI, (unsigned int)opt_ki);
+    Line_Follow_Set_Gain(CMD_DIR_SET_KD, (unsigned int)opt_kd);
+    Line_Follow_Start((unsigned int)opt_seconds);
+
+    while(mode_line_active){
+        double lx, ly, rx, ry, angle, da, xte;
+        int    lost;
+
+        car_step(&c, dt);
+        run_timers(t, &c);
+        Line_Follow_Tick();
+        run_display();
+        step++;
+
+        // Laps: unwrapped angle of the car around the tape centroid.
+        angle = atan2(c.y - t->cy, c.x - t->cx);
+        da    = angle - angle_prev;
+        if(da >  TWO_PI / 2.0) da -= TWO_PI;
+        if(da < -TWO_PI / 2.0) da += TWO_PI;
+        angle_prev = angle;
+        angle_sum += da;
+        if(fabs(angle_sum) >= TWO_PI * (r->laps + 1)){
+            double lap = step * dt - lap_start;
+            lap_start  = step * dt;
+            r->laps++;
+            r->lap_sum += lap;
+            if(lap < r->lap_min) r->lap_min = lap;
+            if(lap > r->lap_max) r->lap_max = lap;
+        }
+
+        // Cross-track error at the sensor pair (what the controller sees).
+        sensor_points(&c, &lx, &ly, &rx, &ry);
+        xte = Track_Cross_Error(t, (lx + rx) / 2.0, (ly + ry) / 2.0);
+        r->xte_sq_sum += xte * xte;
+        if(xte > r->xte_max) r->xte_max = xte;
+        r->samples++;
+
+        // Line loss: both sensors below their calibrated threshold for at
+        // least LOSS_MIN_TIME, after the car has seen the line once.  The
+        // minimum keeps a car chattering along a tape edge from counting
+        // every sample.
+        lost = (ADC_Left_Detect  <= threshold_left) &&
+               (ADC_Right_Detect <= threshold_right);
+        if(!lost){
+            seen_line = 1;
+            lost_time = 0.0;
+        } else if(seen_line){
+            if(lost_time < LOSS_MIN_TIME && lost_time + dt >= LOSS_MIN_TIME){
+                r->line_loss++;
+            }
+            lost_time += dt;
+        }
+
+        if(trace && trace_div > 0 && step % trace_div == 0){
+            fprintf(trace, "%.3f,%.4f,%.4f,%.1f,%u,%u,%u,%u,%u,%u,%u,%.1f\n",
+                    step * dt, c.x, c.y, c.hdg * 360.0 / TWO_PI,
+                    ADC_Left_Detect, ADC_Right_Detect,
+                    TB3CCR1, TB3CCR2, TB3CCR3, TB3CCR4, TB3CCR5,
+                    1000.0 * xte);
+        }
+
+        if(xte > DERAIL_DISTANCE){
+            r->derailed = 1;
+            Quit_Everything();
+        }
+    }
+    r->missed     = lf_missed_periods;
+    r->recoveries = lf_recoveries;
+    r->rec_fails  = lf_recovery_fails;
+    r->rec_ms     = lf_recovery_ms_sum;
+}
+
+static void print_lcd(const char *phase, const lcd_emu_stats_t *s){
+    printf("lcd %-7s %lu refreshes (%lu redundant)  %lu B  %lu chars "
+           "(%lu unchanged)  %.1f s on the wire\n", phase, s->refreshes,
+           s->redundant, s->spi_bytes, s->chars, s->chars_same,
+           s->wire_us / 1e6);
+    if(s->framing_errors){
+        printf("            %lu SPI framing errors\n", s->framing_errors);
+    }
+}
+
+static void usage(const char *prog){
+    fprintf(stderr,
+        "usage: %s [-n episodes] [-t seconds] [-p kp] [-i ki] [-d kd] [-f hz]\n"
+        "          [-m track.pgm -s mm -x m -y m -a deg] [-w out.pgm]\n"
+        "          [-D deadband] [-V vmax] [-N noise] [-S seed] [-c out.csv] [-T trace.csv]\n"
+        "          [-L lcd.txt] [-R trace.txt] [-v]\n",
+        prog);
+}
+
+int main(int argc, char **argv){
+    track_t     track;
+    result_t    r;
+    const char *map_path  = NULL;
+    const char *dump_path = NULL;
+    double      mm_per_px = 2.0;
+    double      sx = -1.0, sy = -1.0, sa = 0.0;
+    FILE       *csv = NULL;
+    FILE       *trace_dump = NULL;
+    int         opt, e;
+    long        total_laps = 0;
+    double      lap_sum = 0.0, lap_min = 1e9, lap_max = 0.0;
+    double      xte_sq = 0.0, xte_max = 0.0;
+    long        samples = 0;
+    long        line_loss = 0;
+    long        missed = 0;
+    long        recoveries = 0, rec_fails = 0, rec_ms = 0;
+    int         derailed = 0;
+    lcd_emu_stats_t lcd_cal, lcd_run;
+    clock_t     wall0;
+    double      wall_s;
+
+    while((opt = getopt(argc, argv, "n:t:p:i:d:f:m:s:x:y:a:w:D:V:N:S:c:T:L:R:vh")) != -1){
+        switch(opt){
+            case 'n': opt_episodes = atoi(optarg);              break;
+            case 't': opt_seconds  = atoi(optarg);              break;
+            case 'p': opt_kp       = atoi(optarg);              break;
+            case 'i': opt_ki       = atoi(optarg);              break;
+            case 'd': opt_kd       = atoi(optarg);              break;
+            case 'f': opt_rate_hz  = atoi(optarg);              break;
+            case 'm': map_path     = optarg;                    break;
+            case 's': mm_per_px    = atof(optarg);              break;
+            case 'x': sx           = atof(optarg);              break;
+            case 'y': sy           = atof(optarg);              break;
+            case 'a': sa           = atof(optarg);              break;
+            case 'w': dump_path    = optarg;                    break;
+            case 'D': opt_deadband = atof(optarg);              break;
+            case 'V': opt_vmax     = atof(optarg);              break;
+            case 'N': opt_noise    = atoi(optarg);              break;
+            case 'S': opt_seed     = (unsigned)strtoul(optarg, NULL, 0); break;
+            case 'c': opt_csv      = optarg;                    break;
+            case 'T':
+                trace = fopen(optarg, "w");
+                if(!trace){
+                    perror(optarg);
+                    return 1;
+                }
+                fprintf(trace, "t,x,y,hdg_deg,adc_l,adc_r,"
+                               "ccr1,ccr2,ccr3,ccr4,ccr5,xte_mm\n");
+                break;
+            case 'L':
+                lcd_log = fopen(optarg, "w");
+                if(!lcd_log){
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'R':
+                trace_dump = fopen(optarg, "w");
+                if(!trace_dump){
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'v': sim_verbose  = 1;                         break;
+            default:  usage(argv[0]);                           return 2;
+        }
+    }
+    // ^N's time field becomes cmd_remaining_ms, a 16-bit count on the car.
+    if(opt_seconds < 1 || opt_seconds > 65 || opt_episodes < 1 ||
+       opt_rate_hz < LF_CTRL_HZ || opt_rate_hz % LF_CTRL_HZ != 0){
+        usage(argv[0]);
+        return 2;
+    }
+    ctrl_div = opt_rate_hz / LF_CTRL_HZ;
+    tick_div = opt_rate_hz * TB0_TICK_MS / 1000;
+    rng_state = opt_seed ? opt_seed : 1;
+
+    if(map_path){
+        if(Track_Load_PGM(&track, map_path, mm_per_px / 1000.0)){
+            return 1;
+        }
+        if(sx < 0.0 || sy < 0.0){
+            fprintf(stderr, "-m needs a start pose (-x -y -a)\n");
+            return 2;
+        }
+        track.start_x       = sx;
+        track.start_y       = sy;
+        track.start_heading = sa * TWO_PI / 360.0;
+    } else if(Track_Build_Oval(&track, OVAL_STRAIGHT, OVAL_RADIUS,
+                               TAPE_WIDTH, mm_per_px / 1000.0)){
+        return 1;
+    }
+    if(dump_path){
+        return Track_Save_PGM(&track, dump_path) ? 1 : 0;
+    }
+
+    Lcd_Emu_Log(lcd_log);
+    Sim_HW_Reset();
+    if(calibrate(&track)){
+        return 1;
+    }
+    Lcd_Emu_Stats(&lcd_cal);                    // power-on + ^C
+    Lcd_Emu_Clear_Stats();
+
+    if(opt_csv){
+        csv = fopen(opt_csv, "w");
+        if(!csv){
+            perror(opt_csv);
+            return 1;
+        }
+        fprintf(csv, "episode,laps,mean_lap_s,min_lap_s,max_lap_s,"
+                     "rms_xte_mm,max_xte_mm,line_loss,derailed\n");
+    }
+
+    wall0 = clock();
+    for(e = 0; e < opt_episodes; e++){
+        run_episode(&track, &r);
+        if(trace){
+            fclose(trace);                      // first episode only
+            trace = NULL;
+        }
+        if(trace_dump){
+            Sim_Trace_Dump(trace_dump);         // boot, ^C and the first ^N
+            fclose(trace_dump);
+            trace_dump = NULL;
+        }
+
+        total_laps += r.laps;
+        lap_sum    += r.lap_sum;
+        if(r.laps && r.lap_min < lap_min) lap_min = r.lap_min;
+        if(r.lap_max > lap_max)           lap_max = r.lap_max;
+        xte_sq     += r.xte_sq_sum;
+        samples    += r.samples;
+        if(r.xte_max > xte_max)           xte_max = r.xte_max;
+        line_loss  += r.line_loss;
+        missed     += r.missed;
+        recoveries += r.recoveries;
+        rec_fails  += r.rec_fails;
+        rec_ms     += (long)r.rec_ms;
+        derailed   += r.derailed;
+
+        if(csv){
+            fprintf(csv, "%d,%d,%.3f,%.3f,%.3f,%.2f,%.2f,%d,%d\n", e, r.laps,
+                    r.laps ? r.lap_sum / r.laps : 0.0,
+                    r.laps ? r.lap_min : 0.0, r.lap_max,
+                    r.samples ? 1000.0 * sqrt(r.xte_sq_sum / r.samples) : 0.0,
+                    1000.0 * r.xte_max, r.line_loss, r.derailed);
+        }
+    }
+    wall_s = (double)(clock() - wall0) / CLOCKS_PER_SEC;
+    Lcd_Emu_Stats(&lcd_run);
+    if(csv){
+        fclose(csv);
+    }
+    if(lcd_log){
+        fclose(lcd_log);
+        Lcd_Emu_Log(NULL);
+    }
+
+    printf("gains       kp %d  ki %d  kd %d (Q8.8)   control %d Hz\n",
+           opt_kp, opt_ki, opt_kd, LF_CTRL_HZ);
+    printf("episodes    %d x %d s   derailed %d\n",
+           opt_episodes, opt_seconds, derailed);
+    printf("laps        %ld\n", total_laps);
+    if(total_laps){
+        printf("lap time    mean %.2f s  min %.2f s  max %.2f s\n",
+               lap_sum / total_laps, lap_min, lap_max);
+    }
+    printf("cross-track rms %.1f mm  max %.1f mm\n",
+           samples ? 1000.0 * sqrt(xte_sq / samples) : 0.0, 1000.0 * xte_max);
+    printf("line loss   %ld", line_loss);
+    if(total_laps){
+        printf("  (%.2f per lap)", (double)line_loss / total_laps);
+    }
+    printf("\n");
+    printf("recoveries  %ld  (mean %.0f ms)  timed out %ld\n", recoveries,
+           recoveries ? (double)rec_ms / recoveries : 0.0, rec_fails);
+    printf("missed      %ld control periods\n", missed);
+    print_lcd("cal", &lcd_cal);
+    print_lcd("run", &lcd_run);
+    printf("speed       %.0f s simulated in %.1f s (%.0fx real time)\n",
+           (double)samples / opt_rate_hz, wall_s,
+           wall_s > 0.0 ? (double)samples / opt_rate_hz / wall_s : 0.0);
+
+    Track_Free(&track);
+    return derailed == opt_episodes ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+//==============================================================================
+// File:        host/sim_hw.c
+// Description: Simulated MCU side of the line-follow simulator.
+//
+//              The simulator links the real modes.c, wheels.c, motor.c,
+//              pid.c, adc.c, fmt.c, display.c and LCD.c (the last against
+//              lcd_emu.c's SPI model).  Everything those files reach into
+//              that is NOT worth simulating (timers.c, iot.c, serial.c) is
+//              provided here as the smallest stand-in
+//              that keeps the real code's behaviour: Time_Sequence wraps at
+//              TIME_SEQ_MAX and the cmd_remaining_ms countdown stops the
+//              wheels exactly the way Vehicle_Cmd_Tick does on the car.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#include <stdio.h>
+#include <string.h>
+#include "msp430.h"
+#include "macros.h"
+#include "ports.h"
+#include "functions.h"
+#include "iot.h"
+#include "adc.h"
+#include "motor.h"
+#include "dac.h"
+#include "LCD.h"
+#include "sim_hw.h"
+#include "lcd_emu.h"
+#include "trace.h"
+
+//------------------------------------------------------------------------------
+// Register file
+//------------------------------------------------------------------------------
+#define SIM_DEF16(n)    volatile unsigned int  n;
+#define SIM_DEF8(n)     volatile unsigned char n;
+SIM_REGS(SIM_DEF16, SIM_DEF8)
+
+int sim_verbose = 0;
+static FILE *sim_usb_file = NULL;           // Sim_Trace_Dump redirect
+
+// LCD.c -- declared per file on the target too
+extern char                   display_line[4][11];
+extern volatile unsigned char update_display;
+
+//------------------------------------------------------------------------------
+// Firmware globals owned by modules the simulator does not link
+//------------------------------------------------------------------------------
+// timers.c
+volatile unsigned int Time_Sequence = 0;
+volatile char         one_time      = 0;
+volatile unsigned int cycle_hi      = 0;
+
+// iot.c
+volatile unsigned int  cmd_remaining_ms = BEGINNING;
+volatile char          cmd_active_dir   = SERIAL_NULL;
+volatile unsigned int  cmd_active_time  = BEGINNING;
+
+// interrupts_ports.c
+volatile unsigned int  sw1_pressed     = 0;
+volatile unsigned int  sw2_pressed     = 0;
+
+// adc.c's ISR is not prototyped in a header on the target
+void ADC_ISR(void);
+
+//------------------------------------------------------------------------------
+// Firmware functions owned by modules the simulator does not link
+//------------------------------------------------------------------------------
+void USB_transmit_string(const char *str){
+    if(sim_usb_file){
+        fputs(str, sim_usb_file);
+    } else if(sim_verbose){
+        fputs(str, stdout);
+    }
+}
+
+void Display_Network_Info(void){
+}
+
+// dac.c -- the rail is taken as already settled at power-on.
+unsigned char DAC_Seq_Busy(void){
+    return 0;
+}
+
+unsigned char DAC_Seq_Profile(void){
+    return DAC_PROFILE_NORMAL;
+}
+
+void DAC_Seq_Stop(void){
+}
+
+// Same countdown as iot.c Vehicle_Cmd_Tick.
+void Vehicle_Cmd_Tick(void){
+    if(cmd_remaining_ms == BEGINNING){
+        return;
+    }
+    if(cmd_remaining_ms <= TB0_TICK_MS){
+        TRACE(TR_CMD_DONE, cmd_active_dir, 0);
+        cmd_remaining_ms = BEGINNING;
+        cmd_active_dir   = SERIAL_NULL;
+        Wheels_All_Off();
+    } else {
+        cmd_remaining_ms -= TB0_TICK_MS;
+    }
+}
+
+//==============================================================================
+// Sim_HW_Reset -- the register and global state Init_Ports / Init_Timers /
+// Init_ADC leave behind on the car, as far as the line-follow path cares.
+//==============================================================================
+void Sim_HW_Reset(void){
+    TB0CTL   = TBSSEL__SMCLK | MC__CONTINUOUS;     // DAC profile finished (TBIE off)
+    TB3CCR0  = WHEEL_PERIOD_VAL;
+    TB3CCR1  = 0;
+    TB3CCR2  = 0;
+    TB3CCR3  = 0;
+    TB3CCR4  = 0;
+    TB3CCR5  = 0;
+    P6SEL0   = P6_5;                               // TB3.5 -> RIGHT_REVERSE
+    P6DIR    = P6_5;
+    ADCMCTL0 = ADCINCH_2;
+    ADCCTL0  = ADCON | ADCENC;
+    TB1CCTL0 = CCIE;
+    Motor_Halt();
+    Motor_Release(MOTOR_SRC_ESTOP);                // power-on, not a ^Q
+
+    Time_Sequence    = 0;
+    cmd_remaining_ms = BEGINNING;
+    cmd_active_dir   = SERIAL_NULL;
+    cmd_active_time  = BEGINNING;
+    memset(display_line, RESET_STATE, sizeof(display_line));  // Init_Conditions
+    update_display   = 0;
+    Lcd_Emu_Reset();
+    Init_LCD();
+    Display_Invalidate();
+    Lcd_Emu_Pump(0);
+    Trace_Init();
+}
+
+//==============================================================================
+// Sim_Control_Tick -- Timer1_B0_ISR (motor ramp step, then the A2/A3/A5/A10
+// sweep it starts).  Each conversion loads ADCMEM0 with the value for
+// whatever channel adc.c selected last and runs the real ISR, so
+// ADC_frame_count is advanced by adc.c itself.  The rail reads as exactly
+// on target (dac.c's regulator is not simulated; the wheel model assumes a
+// constant supply).
+//==============================================================================
+void Sim_Control_Tick(unsigned int left, unsigned int right, unsigned int thumb){
+    unsigned int i;
+
+    Motor_Ramp_Tick();
+    ADC_Start_Sweep();
+    for(i = 0; i < 4; i++){
+        switch(ADCMCTL0 & ADCINCH_15){
+            case ADCINCH_2:  ADCMEM0 = left;  break;
+            case ADCINCH_3:  ADCMEM0 = right; break;
+            case ADCINCH_5:  ADCMEM0 = thumb; break;
+            case ADCINCH_10: ADCMEM0 = RAIL_TARGET_COUNTS; break;
+            default:         ADCMEM0 = 0;     break;
+        }
+        ADCIV = ADCIV_ADCIFG;
+        ADC_ISR();
+    }
+}
+
+//==============================================================================
+// Sim_Timer_Tick -- the parts of Timer0_B0_ISR the line-follow path uses.
+//==============================================================================
+void Sim_Timer_Tick(void){
+    update_display = TRUE;
+    if(Time_Sequence >= TIME_SEQ_MAX){
+        Time_Sequence = RESET_STATE;
+    } else {
+        Time_Sequence++;
+    }
+    Vehicle_Cmd_Tick();
+}
+
+//==============================================================================
+// Sim_Display_Tick -- the main loop's Display_Process, with the bytes it
+// queues clocked straight out to the LCD model.
+//==============================================================================
+void Sim_Display_Tick(unsigned long now_ms){
+    Display_Process();
+    Lcd_Emu_Pump(now_ms);
+}
+
+//==============================================================================
+// Wheel decode.  CCR1/P6.1 is not routed to the H-bridge on this car, and
+// CCR5 only reaches RIGHT_REVERSE while P6.5 is in its TB3.5 function.
+//==============================================================================
+int Sim_Left_Drive(void){
+    return (int)LEFT_FORWARD_SPEED - (int)LEFT_REVERSE_SPEED;
+}
+
+int Sim_Right_Drive(void){
+    int rev = (P6SEL0 & P6_5) ? (int)RIGHT_REVERSE_SPEED : 0;
+    return (int)RIGHT_FORWARD_SPEED - rev;
+}
+
+//==============================================================================
+// Sim_Set_Cycles -- Timer B2 + cycle_hi for a simulated SMCLK cycle count,
+// so trace timestamps follow simulated time.
+//==============================================================================
+void Sim_Set_Cycles(unsigned long cycles){
+    TB2R     = (unsigned int)(cycles & 0xFFFFUL);
+    cycle_hi = (unsigned int)((cycles >> 16) & 0xFFFFUL);
+}
+
+//==============================================================================
+// Sim_Trace_Dump -- what ^T prints on the car, written to f.  One
+// Trace_Dump_Process call per main-loop pass, as many passes as the dump takes.
+//==============================================================================
+void Sim_Trace_Dump(FILE *f){
+    int pass;
+
+    sim_usb_file = f;
+    Trace_Dump_Request();
+    for(pass = 0; pass < TRACE_DEPTH + 2; pass++){
+        Trace_Dump_Process();
+    }
+    sim_usb_file = NULL;
+}
@@ -0,0 +1,37 @@
+//==============================================================================
+// File:        host/sim_hw.h
+// Description: Simulated MCU side of the line-follow simulator: the register
+//              file, the firmware globals/functions that live in modules the
+//              simulator does not link (timers.c, iot.c, serial.c), the two
+//              "hardware events" the simulator injects -- one Timer B1
+//              control tick (with the ADC sweep it starts) and one Timer B0
+//              200 ms tick -- and the main loop's display refresh and ^T
+//              trace dump.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#ifndef SIM_HW_H_
+#define SIM_HW_H_
+
+#include <stdio.h>
+
+extern int sim_verbose;                 // 1 = echo firmware USB text to stdout
+extern volatile unsigned int sw1_pressed;   // interrupts_ports.c on the car
+
+void Sim_HW_Reset(void);                // Power-on register/global state
+void Sim_Control_Tick(unsigned int left, unsigned int right, unsigned int thumb);
+void Sim_Timer_Tick(void);              // One TB0 CCR0 interrupt (200 ms)
+void Sim_Display_Tick(unsigned long now_ms);  // Display_Process + LCD model
+void Sim_Set_Cycles(unsigned long cycles);    // Timer B2 / cycle_hi (trace.c)
+void Sim_Trace_Dump(FILE *f);           // ^T output to f
+
+// Physical wheel drive in signed PWM counts, decoded from TB3 CCRs using the
+// car's empirical H-bridge wiring (ports.h).
+int  Sim_Left_Drive(void);
+int  Sim_Right_Drive(void);
+
+#endif /* SIM_HW_H_ */
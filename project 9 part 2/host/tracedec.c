@@ -0,0 +1,301 @@
+//==============================================================================
+// File:        host/tracedec.c
+// Description: ^T trace dump -> Chrome trace JSON.
+//
+//   Reads a terminal capture (Termite log, linesim -R, ...) containing a
+//   dump in the format documented in trace.h and writes JSON that loads in
+//   chrome://tracing or ui.perfetto.dev.  With several dumps in the capture
+//   the last complete one is used.
+//
+//   One track per area: system (boot, quit), IoT link state, commands,
+//   calibration, line follow.  The IoT / calibration / line-follow state
+//   changes become spans lasting until the next change on that track;
+//   everything else is an instant event with a and b as arguments.
+//
+//   Timestamps are the 32-bit SMCLK cycle count; wraps (every ~9 minutes at
+//   8 MHz) are unwrapped, and a boot event starts a new epoch right after
+//   the last event before it, since the counter restarts at reset.
+//
+// Usage: tracedec [capture.txt] > trace.json      (stdin if no file)
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "macros.h"
+#include "trace.h"
+
+#define LINE_LEN        (256)
+#define MAX_EVENTS      (4096)
+
+// Tracks (Chrome "tid")
+enum { TK_SYSTEM, TK_IOT, TK_CMD, TK_CAL, TK_LINE, TK_COUNT };
+
+static const char *const track_name[TK_COUNT] = {
+    "system", "iot link", "commands", "calibration", "line follow"
+};
+
+// State names -- IOT_STATE_* (iot.c), CAL_ST_* and LF_* (modes.c)
+static const char *const iot_state_name[] = {
+    "wait ready", "send AT", "wait AT OK", "wait wifi", "send CIPMUX",
+    "send server", "send CIFSR", "wait IP", "running"
+};
+static const char *const cal_state_name[] = {
+    "prompt white", "wait white", "sample white", "prompt black",
+    "wait black", "sample black", "finish"
+};
+static const char *const lf_state_name[] = {
+    "seek", "pause", "align", "follow", "recover"
+};
+
+static const char *const err_name[] = {
+    "?", "bad dir", "bad PIN", "bad time", "no ':'", "queue full",
+    "no cmd", "bad profile"
+};
+
+#define COUNT_OF(a)     (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+    unsigned long long t;           // Cycles, unwrapped
+    unsigned int       id;
+    unsigned int       a;
+    unsigned int       b;
+} event_t;
+
+static event_t       ev[MAX_EVENTS];
+static int           n_ev;
+static unsigned long hz = TRACE_HZ;
+
+// Open span per state track
+typedef struct {
+    int                open;
+    unsigned long long t;
+    const char        *name;
+} span_t;
+
+static span_t span[TK_COUNT];
+static int    first_out = 1;
+
+static const char *event_name(unsigned int id){
+#define TRACE_NAME(name, value, text)   case value: return text;
+    switch(id){
+        TRACE_EVENTS(TRACE_NAME)
+        default: return "unknown";
+    }
+#undef TRACE_NAME
+}
+
+static int event_track(unsigned int id){
+    switch(id){
+        case TR_IOT_STATE:  return TK_IOT;
+        case TR_IPD:
+        case TR_CMD_ERR:
+        case TR_CMD_START:
+        case TR_CMD_DONE:   return TK_CMD;
+        case TR_CAL_STATE:  return TK_CAL;
+        case TR_LF_STATE:
+        case TR_LF_FOUND:
+        case TR_LF_LOST:
+        case TR_LF_END:     return TK_LINE;
+        default:            return TK_SYSTEM;
+    }
+}
+
+static const char *table(const char *const *names, size_t n, unsigned int i){
+    return i < n ? names[i] : "?";
+}
+
+static double us(unsigned long long t){
+    return (double)t * 1e6 / (double)hz;
+}
+
+static void sep(void){
+    printf(first_out ? "\n" : ",\n");
+    first_out = 0;
+}
+
+static void close_span(int tk, unsigned long long t){
+    if(!span[tk].open){
+        return;
+    }
+    sep();
+    printf("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+           "\"ts\":%.3f,\"dur\":%.3f}",
+           span[tk].name, tk, us(span[tk].t), us(t - span[tk].t));
+    span[tk].open = 0;
+}
+
+static void open_span(int tk, unsigned long long t, const char *name){
+    close_span(tk, t);
+    span[tk].open = 1;
+    span[tk].t    = t;
+    span[tk].name = name;
+}
+
+static void instant(const event_t *e){
+    char detail[32] = "";
+
+    switch(e->id){
+        case TR_CMD_ERR:
+            snprintf(detail, sizeof detail, ",\"error\":\"%s\"",
+                     table(err_name, COUNT_OF(err_name), e->a));
+            break;
+        case TR_CMD_START:
+        case TR_CMD_DONE:
+            if(e->a >= ' ' && e->a < 0x7F){
+                snprintf(detail, sizeof detail, ",\"dir\":\"%c\"", e->a);
+            }
+            break;
+        default:
+            break;
+    }
+    sep();
+    printf("{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,"
+           "\"ts\":%.3f,\"args\":{\"a\":%u,\"b\":%u%s}}",
+           event_name(e->id), event_track(e->id), us(e->t), e->a, e->b, detail);
+}
+
+//------------------------------------------------------------------------------
+// read_dump -- keep the events of the last complete dump in the capture
+//------------------------------------------------------------------------------
+static int read_dump(FILE *f){
+    char               line[LINE_LEN];
+    int                in_dump = 0;
+    int                n = 0;
+    int                found = 0;
+    unsigned long      depth, rate, count, dropped;
+    unsigned long      t;
+    unsigned int       id, a, b;
+    unsigned long long base = 0;
+    unsigned long long last = 0;
+    unsigned long      prev = 0;
+
+    while(fgets(line, sizeof line, f)){
+        if(sscanf(line, " TRACE end %lu", &dropped) == 1){
+            if(in_dump){
+                n_ev    = n;
+                found   = 1;
+                in_dump = 0;
+                if(dropped){
+                    fprintf(stderr, "tracedec: %lu events dropped during dump\n",
+                            dropped);
+                }
+            }
+            continue;
+        }
+        if(sscanf(line, " TRACE %lu %lu %lu", &depth, &rate, &count) == 3){
+            in_dump = 1;
+            n       = 0;
+            base    = 0;
+            last    = 0;
+            prev    = 0;
+            hz      = rate ? rate : TRACE_HZ;
+            continue;
+        }
+        if(!in_dump || sscanf(line, " %8lx %2x %2x %4x", &t, &id, &a, &b) != 4){
+            continue;
+        }
+        if(n >= MAX_EVENTS){
+            continue;
+        }
+        if(id == TR_BOOT && n > 0){
+            base = last;                // Counter restarted at reset
+        } else if(n > 0 && t < prev){
+            base += 0x100000000ULL;     // 32-bit wrap
+        }
+        prev        = t;
+        ev[n].t     = base + t;
+        ev[n].id    = id;
+        ev[n].a     = a;
+        ev[n].b     = b;
+        last        = ev[n].t;
+        n++;
+    }
+    return found;
+}
+
+int main(int argc, char **argv){
+    FILE               *f = stdin;
+    unsigned long long  t0, t_end;
+    int                 i, tk;
+
+    if(argc > 2){
+        fprintf(stderr, "usage: tracedec [capture.txt] > trace.json\n");
+        return 2;
+    }
+    if(argc == 2){
+        f = fopen(argv[1], "r");
+        if(!f){
+            perror(argv[1]);
+            return 1;
+        }
+    }
+    if(!read_dump(f)){
+        fprintf(stderr, "tracedec: no complete TRACE ... TRACE end dump found\n");
+        return 1;
+    }
+    if(f != stdin){
+        fclose(f);
+    }
+
+    // Start the timeline at the oldest event.
+    t0 = n_ev ? ev[0].t : 0;
+    for(i = 0; i < n_ev; i++){
+        ev[i].t -= t0;
+    }
+    t_end = n_ev ? ev[n_ev - 1].t : 0;
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for(tk = 0; tk < TK_COUNT; tk++){
+        sep();
+        printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+               "\"args\":{\"name\":\"%s\"}}", tk, track_name[tk]);
+    }
+
+    for(i = 0; i < n_ev; i++){
+        const event_t *e = &ev[i];
+
+        switch(e->id){
+            case TR_BOOT:
+                for(tk = 0; tk < TK_COUNT; tk++){
+                    close_span(tk, e->t);
+                }
+                instant(e);
+                break;
+            case TR_QUIT:
+                close_span(TK_CAL, e->t);
+                close_span(TK_LINE, e->t);
+                instant(e);
+                break;
+            case TR_IOT_STATE:
+                open_span(TK_IOT, e->t,
+                          table(iot_state_name, COUNT_OF(iot_state_name), e->a));
+                break;
+            case TR_CAL_STATE:
+                open_span(TK_CAL, e->t,
+                          table(cal_state_name, COUNT_OF(cal_state_name), e->a));
+                break;
+            case TR_LF_STATE:
+                open_span(TK_LINE, e->t,
+                          table(lf_state_name, COUNT_OF(lf_state_name), e->a));
+                break;
+            case TR_LF_END:
+                close_span(TK_LINE, e->t);
+                instant(e);
+                break;
+            default:
+                instant(e);
+                break;
+        }
+    }
+    for(tk = 0; tk < TK_COUNT; tk++){
+        close_span(tk, t_end);
+    }
+    printf("\n]}\n");
+    return 0;
+}
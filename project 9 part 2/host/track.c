@@ -0,0 +1,266 @@
+//==============================================================================
+// File:        host/track.c
+// Description: Bitmap track loading, generation and lookups for the
+//              line-follow simulator.  See track.h.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "track.h"
+
+#define INK_THRESHOLD   (128)       // >= this is tape
+#define DT_DIAG         (1.41421356f)
+#define DT_FAR          (1.0e9f)
+
+//------------------------------------------------------------------------------
+// Two-pass chamfer distance transform: out[i] = pixels from i to the nearest
+// pixel where (ink >= INK_THRESHOLD) == want_black.  Within a few percent of
+// Euclidean, which is plenty for an error metric.
+//------------------------------------------------------------------------------
+static void distance_map(const track_t *t, int want_black, float *out){
+    int x, y;
+    int w = t->w;
+    int h = t->h;
+
+    for(y = 0; y < h; y++){
+        for(x = 0; x < w; x++){
+            int black = (t->ink[y * w + x] >= INK_THRESHOLD);
+            out[y * w + x] = (black == want_black) ? 0.0f : DT_FAR;
+        }
+    }
+    for(y = 0; y < h; y++){
+        for(x = 0; x < w; x++){
+            float d = out[y * w + x];
+            if(x > 0                && out[y * w + x - 1] + 1.0f < d)            d = out[y * w + x - 1] + 1.0f;
+            if(y > 0                && out[(y - 1) * w + x] + 1.0f < d)          d = out[(y - 1) * w + x] + 1.0f;
+            if(x > 0 && y > 0       && out[(y - 1) * w + x - 1] + DT_DIAG < d)   d = out[(y - 1) * w + x - 1] + DT_DIAG;
+            if(x < w - 1 && y > 0   && out[(y - 1) * w + x + 1] + DT_DIAG < d)   d = out[(y - 1) * w + x + 1] + DT_DIAG;
+            out[y * w + x] = d;
+        }
+    }
+    for(y = h - 1; y >= 0; y--){
+        for(x = w - 1; x >= 0; x--){
+            float d = out[y * w + x];
+            if(x < w - 1               && out[y * w + x + 1] + 1.0f < d)          d = out[y * w + x + 1] + 1.0f;
+            if(y < h - 1               && out[(y + 1) * w + x] + 1.0f < d)        d = out[(y + 1) * w + x] + 1.0f;
+            if(x < w - 1 && y < h - 1  && out[(y + 1) * w + x + 1] + DT_DIAG < d) d = out[(y + 1) * w + x + 1] + DT_DIAG;
+            if(x > 0 && y < h - 1      && out[(y + 1) * w + x - 1] + DT_DIAG < d) d = out[(y + 1) * w + x - 1] + DT_DIAG;
+            out[y * w + x] = d;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Build the distance maps, the tape centroid and the tape half-width once the
+// image is in place.
+//------------------------------------------------------------------------------
+static int track_prepare(track_t *t){
+    long   n = (long)t->w * t->h;
+    long   i;
+    long   count = 0;
+    double sx = 0.0;
+    double sy = 0.0;
+    float  widest = 0.0f;
+
+    t->d_black = malloc(n * sizeof(float));
+    t->d_white = malloc(n * sizeof(float));
+    if(!t->d_black || !t->d_white){
+        return -1;
+    }
+    distance_map(t, 1, t->d_black);
+    distance_map(t, 0, t->d_white);
+
+    for(i = 0; i < n; i++){
+        if(t->ink[i] >= INK_THRESHOLD){
+            sx += (double)(i % t->w);
+            sy += (double)(t->h - 1 - i / t->w);
+            count++;
+            if(t->d_white[i] > widest){
+                widest = t->d_white[i];
+            }
+        }
+    }
+    if(count == 0){
+        fprintf(stderr, "track: image has no tape pixels\n");
+        return -1;
+    }
+    t->cx         = (sx / count + 0.5) * t->mpp;
+    t->cy         = (sy / count + 0.5) * t->mpp;
+    t->half_width = (widest - 0.5) * t->mpp;
+    return 0;
+}
+
+static int track_alloc(track_t *t, int w, int h, double mpp){
+    memset(t, 0, sizeof(*t));
+    t->w   = w;
+    t->h   = h;
+    t->mpp = mpp;
+    t->ink = calloc((size_t)w * h, 1);
+    return t->ink ? 0 : -1;
+}
+
+//==============================================================================
+// Track_Build_Oval -- stadium-shaped track: two straights of length
+// `straight` joined by semicircles of `radius` (both on the tape centreline).
+// The car starts mid-way along the top straight heading +x, so it laps
+// clockwise.
+//==============================================================================
+int Track_Build_Oval(track_t *t, double straight, double radius,
+                     double tape_width, double mpp){
+    double margin = 0.15;
+    double width  = straight + 2.0 * radius + 2.0 * margin;
+    double height = 2.0 * radius + 2.0 * margin;
+    double ox     = width  / 2.0;
+    double oy     = height / 2.0;
+    int    x, y;
+
+    if(track_alloc(t, (int)(width / mpp), (int)(height / mpp), mpp)){
+        return -1;
+    }
+    for(y = 0; y < t->h; y++){
+        for(x = 0; x < t->w; x++){
+            double wx = (x + 0.5) * mpp - ox;
+            double wy = (t->h - y - 0.5) * mpp - oy;
+            double d;
+            if(fabs(wx) <= straight / 2.0){
+                d = fabs(fabs(wy) - radius);
+            } else {
+                d = fabs(hypot(fabs(wx) - straight / 2.0, wy) - radius);
+            }
+            t->ink[y * t->w + x] = (d <= tape_width / 2.0) ? 255 : 0;
+        }
+    }
+    t->start_x       = ox;
+    t->start_y       = oy + radius;
+    t->start_heading = 0.0;
+    return track_prepare(t);
+}
+
+//==============================================================================
+// Track_Load_PGM -- binary (P5) 8-bit grey image.  Dark pixels are tape, so
+// a photo or a drawing of the real course works after thresholding.
+//==============================================================================
+int Track_Load_PGM(track_t *t, const char *path, double mpp){
+    FILE *f = fopen(path, "rb");
+    char  magic[3] = {0};
+    int   w, h, maxval;
+    int   c;
+    long  i, n;
+
+    if(!f){
+        perror(path);
+        return -1;
+    }
+    if(fscanf(f, "%2s", magic) != 1 || strcmp(magic, "P5") != 0){
+        fprintf(stderr, "%s: not a binary PGM (P5)\n", path);
+        fclose(f);
+        return -1;
+    }
+    // Skip '#' comment lines between header fields.
+    while((c = fgetc(f)) != EOF){
+        if(c == '#'){
+            while((c = fgetc(f)) != EOF && c != '\n'){}
+        } else if(c > ' '){
+            ungetc(c, f);
+            break;
+        }
+    }
+    if(fscanf(f, "%d %d %d", &w, &h, &maxval) != 3 || maxval != 255){
+        fprintf(stderr, "%s: need 8-bit PGM\n", path);
+        fclose(f);
+        return -1;
+    }
+    fgetc(f);                                   // single whitespace byte
+    if(track_alloc(t, w, h, mpp)){
+        fclose(f);
+        return -1;
+    }
+    n = (long)w * h;
+    if(fread(t->ink, 1, n, f) != (size_t)n){
+        fprintf(stderr, "%s: short read\n", path);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    for(i = 0; i < n; i++){
+        t->ink[i] = (unsigned char)(255 - t->ink[i]);   // PGM: 0 = black
+    }
+    return track_prepare(t);
+}
+
+int Track_Save_PGM(const track_t *t, const char *path){
+    FILE *f = fopen(path, "wb");
+    long  i, n = (long)t->w * t->h;
+
+    if(!f){
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "P5\n# %.4f m/px\n%d %d\n255\n", t->mpp, t->w, t->h);
+    for(i = 0; i < n; i++){
+        fputc(255 - t->ink[i], f);
+    }
+    fclose(f);
+    return 0;
+}
+
+void Track_Free(track_t *t){
+    free(t->ink);
+    free(t->d_black);
+    free(t->d_white);
+    memset(t, 0, sizeof(*t));
+}
+
+//==============================================================================
+// Track_Ink -- bilinear tape coverage at a world point (off-image = floor).
+//==============================================================================
+static double ink_at(const track_t *t, int px, int py){
+    if(px < 0 || py < 0 || px >= t->w || py >= t->h){
+        return 0.0;
+    }
+    return t->ink[py * t->w + px] / 255.0;
+}
+
+double Track_Ink(const track_t *t, double x, double y){
+    double fx = x / t->mpp - 0.5;
+    double fy = (t->h - y / t->mpp) - 0.5;
+    int    px = (int)floor(fx);
+    int    py = (int)floor(fy);
+    double ax = fx - px;
+    double ay = fy - py;
+
+    return (1.0 - ay) * ((1.0 - ax) * ink_at(t, px, py)     + ax * ink_at(t, px + 1, py))
+         +        ay  * ((1.0 - ax) * ink_at(t, px, py + 1) + ax * ink_at(t, px + 1, py + 1));
+}
+
+//==============================================================================
+// Track_Cross_Error -- unsigned distance (metres) from a point to the tape
+// centreline, assuming constant tape width: on the floor it is the distance
+// to the tape plus half a width, on the tape it is half a width minus the
+// distance to the floor.
+//==============================================================================
+double Track_Cross_Error(const track_t *t, double x, double y){
+    int  px = (int)(x / t->mpp);
+    int  py = t->h - 1 - (int)(y / t->mpp);
+    long i;
+    double e;
+
+    if(px < 0)      px = 0;
+    if(py < 0)      py = 0;
+    if(px >= t->w)  px = t->w - 1;
+    if(py >= t->h)  py = t->h - 1;
+    i = (long)py * t->w + px;
+
+    if(t->ink[i] >= INK_THRESHOLD){
+        e = t->half_width - (t->d_white[i] - 0.5) * t->mpp;
+        return e > 0.0 ? e : 0.0;
+    }
+    return t->half_width + (t->d_black[i] - 0.5) * t->mpp;
+}
@@ -0,0 +1,44 @@
+//==============================================================================
+// File:        host/track.h
+// Description: Bitmap track for the line-follow simulator.  A track is a
+//              grey-scale image (0 = white floor, 255 = black tape) with a
+//              fixed metres-per-pixel scale, plus two distance maps built
+//              once at load time so cross-track error is a table lookup.
+//
+//              World coordinates are metres, x right, y up, origin at the
+//              bottom-left corner of the image.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: gcc (host)
+// Target: Linux
+//==============================================================================
+
+#ifndef TRACK_H_
+#define TRACK_H_
+
+typedef struct {
+    int            w;               // Image size, pixels
+    int            h;
+    double         mpp;             // Metres per pixel
+    unsigned char *ink;             // w*h, row 0 = top of image
+    float         *d_black;         // Pixels to nearest tape pixel
+    float         *d_white;         // Pixels to nearest floor pixel
+    double         half_width;      // Tape half-width, metres
+    double         cx;              // Tape centroid (lap counting pivot)
+    double         cy;
+    double         start_x;         // Start pose (built-in track only)
+    double         start_y;
+    double         start_heading;   // Radians, 0 = +x
+} track_t;
+
+int    Track_Build_Oval(track_t *t, double straight, double radius,
+                        double tape_width, double mpp);
+int    Track_Load_PGM(track_t *t, const char *path, double mpp);
+int    Track_Save_PGM(const track_t *t, const char *path);
+void   Track_Free(track_t *t);
+
+double Track_Ink(const track_t *t, double x, double y);   // 0.0 .. 1.0
+double Track_Cross_Error(const track_t *t, double x, double y);
+
+#endif /* TRACK_H_ */
@@ -11,6 +11,14 @@
 //             DEBOUNCE_THRESHOLD x 200 ms (~1 second)
 //     - CCR2: SW2 debounce countdown -- re-enables SW2 interrupt after
 //             DEBOUNCE_THRESHOLD x 200 ms (~1 second)
+//     - Overflow: one step of the motor rail profile (dac.c DAC_Seq_Tick)
+//
+//   Timer1_B0_ISR (CCR0, every 1 / LF_CTRL_HZ):
+//     - Steps the motor slew limiter (motor.c) and rail regulator (dac.c)
+//     - Starts one ADC sweep; Line_Follow_Tick runs when it completes
+//
+//   TIMER2_B1_ISR (TB2 overflow, every 65,536 cycles):
+//     - Carries the free-running cycle counter into cycle_hi (loopstat.c)
 //
 // Author: Thomas Gilbert
 // Date: Mar 2026
@@ -22,6 +30,9 @@
 #include "functions.h"
 #include "macros.h"
 #include "ports.h"
+#include "adc.h"
+#include "motor.h"
+#include "dac.h"
 
 //==============================================================================
 // Global variables (declared extern in functions.h)
@@ -35,14 +46,11 @@ volatile unsigned int sw2_debounce_count = RESET_STATE;
 // From timers.c
 extern volatile unsigned int Time_Sequence;
 extern volatile char         one_time;
+extern volatile unsigned int cycle_hi;
 
-// From LCD.obj
+// From LCD.c
 extern volatile unsigned char update_display;
 
-// From dac.c
-extern volatile unsigned int DAC_data;
-extern volatile unsigned int dac_startup_ticks;
-
 //==============================================================================
 // ISR: Timer0_B0_ISR
 // Fires every 200 ms. Sets update_display flag and advances Time_Sequence.
@@ -69,6 +77,17 @@ __interrupt void Timer0_B0_ISR(void){
     TB0CCR0 += TB0CCR0_INTERVAL;
 }
 
+//==============================================================================
+// ISR: Timer1_B0_ISR
+// Line-follow control clock.  Up mode reloads by itself, nothing to re-arm.
+//==============================================================================
+#pragma vector = TIMER1_B0_VECTOR
+__interrupt void Timer1_B0_ISR(void){
+    Motor_Ramp_Tick();
+    DAC_Regulate();
+    ADC_Start_Sweep();
+}
+
 //==============================================================================
 // ISR: TIMER0_B1_ISR
 // Handles CCR1 (SW1 debounce) and CCR2 (SW2 debounce).
@@ -103,34 +122,25 @@ __interrupt void TIMER0_B1_ISR(void){
             TB0CCR2 += TB0CCR2_INTERVAL;      // Re-arm CCR2 for next 200 ms
             break;
 
-        case 14:                              // Timer overflow -- DAC enable + ramp
-            // Phase 1: wait DAC_ENABLE_TICKS overflows before enabling buck-boost.
-            //   This lets the DAC output settle before the LT1935 sees it.
-            // Phase 2: decrement DAC_data by DAC_RAMP_STEP each tick.
-            //   Lower DAC value = higher motor supply voltage (inverted).
-            //   Stop when DAC_data <= DAC_Limit: set DAC_Adjust, clear TBIE.
-            if(!(P2OUT & DAC_ENB)){
-                // Phase 1 -- settling delay
-                dac_startup_ticks++;
-                if(dac_startup_ticks >= DAC_ENABLE_TICKS){
-                    P2OUT |= DAC_ENB;         // Enable buck-boost converter
-                    P1OUT |= RED_LED;         // RED LED ON -- ramp starting
-                }
-            } else {
-                // Phase 2 -- ramp down toward motor operating voltage
-                if(DAC_data >= (DAC_Limit + DAC_RAMP_STEP)){
-                    DAC_data -= DAC_RAMP_STEP;
-                } else {
-                    DAC_data = DAC_Adjust;
-                }
-                SAC3DAT = DAC_data;
-                if(DAC_data <= DAC_Limit){
-                    DAC_data = DAC_Adjust;
-                    SAC3DAT  = DAC_data;
-                    TB0CTL  &= ~TBIE;         // Disable overflow interrupt
-                    P1OUT   &= ~RED_LED;      // RED LED OFF -- ramp done
-                }
-            }
+        case 14:                              // Timer overflow -- DAC rail sequencer
+            DAC_Seq_Tick();
+            break;
+
+        default:
+            break;
+    }
+}
+
+//==============================================================================
+// ISR: TIMER2_B1_ISR
+// TB2 overflow -- high word of the cycle counter.  Reading TB2IV clears
+// TBIFG.
+//==============================================================================
+#pragma vector = TIMER2_B1_VECTOR
+__interrupt void TIMER2_B1_ISR(void){
+    switch(__even_in_range(TB2IV, 14)){
+        case 14:                              // Overflow
+            cycle_hi++;
             break;
 
         default:
@@ -13,6 +13,9 @@
 //    7) loops watching IOT_Data[][] for "+IPD,..."  lines from the TCP client
 //       and decodes the protocol  ^<PIN><dir><time-units>  (e.g. ^1234F0010).
 //
+//  ^1234?000n is answered on the TCP link it came from with the STATS line
+//  (stats.h), sent through AT+CIPSEND once the ESP32 shows its '>' prompt.
+//
 //  The motor command runs for time_units * CMD_TIME_UNIT_MS milliseconds,
 //  then Vehicle_Cmd_Tick() (called from the 200 ms Timer B0 ISR) auto-stops
 //  the wheels.
@@ -31,12 +34,15 @@
 #include "serial.h"
 #include "iot.h"
 #include "modes.h"
+#include "dac.h"
+#include "fmt.h"
+#include "trace.h"
+#include "stats.h"
 
 //==============================================================================
 // External LCD globals
 //==============================================================================
 extern char                  display_line[4][11];
-extern volatile unsigned char display_changed;
 
 //==============================================================================
 // Module globals
@@ -63,6 +69,7 @@ volatile unsigned int  cmd_active_time  = BEGINNING;
 
 static unsigned int  iot_state    = IOT_STATE_WAIT_READY;
 static unsigned long iot_wait_cnt = BEGINNING;
+static unsigned int  iot_traced   = 0xFFFF;     // Last iot_state put in the trace
 
 //==============================================================================
 // AT command strings (CR+LF appended -- caller uses Serial_Transmit as-is)
@@ -101,9 +108,7 @@ static int find_in_iot_data(const char *needle){
 // Helper: build "AT+CIPSERVER=1,<IOT_TCP_PORT>\r\n" into AT_CIPSERVER[]
 //==============================================================================
 static void build_cipserver_string(void){
-    unsigned int port = IOT_TCP_PORT;
-    char digits[6];
-    int  d = 0;
+    char *end;
     int  i = 0;
     const char prefix[] = "AT+CIPSERVER=1,";
 
@@ -112,21 +117,101 @@ static void build_cipserver_string(void){
         AT_CIPSERVER[i] = prefix[i];
         i++;
     }
-    // Convert port to ASCII digits (reversed)
-    if(port == 0){
-        digits[d++] = '0';
+    // Port digits, no padding
+    end = Fmt_Dec(&AT_CIPSERVER[i], IOT_TCP_PORT, 0, FMT_SPACE);
+    *end++ = SERIAL_CR;
+    *end++ = SERIAL_LF;
+    *end   = SERIAL_NULL;
+}
+
+//==============================================================================
+// STATS reply over TCP.  Parse_IPD_Command records the link and arms it;
+// the RUNNING state sends AT+CIPSEND=<link>,<len>, waits for the '>' prompt
+// (a row starting with '>'), then sends the line.  A request that arrives
+// while a reply is in flight is latched and sent after it: a second
+// CIPSEND while the ESP32 waits for payload would go out as TCP data.
+//==============================================================================
+#define STATS_TX_IDLE       (0)
+#define STATS_TX_PENDING    (1)     // Waiting for UCA0 TX to be free
+#define STATS_TX_PROMPT     (2)     // CIPSEND sent, waiting for '>'
+
+static unsigned char stats_tx      = STATS_TX_IDLE;
+static unsigned char stats_tx_how  = STATS_REPORT;
+static char          stats_tx_link = '0';
+static unsigned int  stats_tx_wait = BEGINNING;
+static char          stats_tx_line[STATS_LINE_LEN];
+static unsigned char stats_tx_next      = FALSE; // Request latched while busy
+static unsigned char stats_tx_next_how  = STATS_REPORT;
+static char          stats_tx_next_link = '0';
+
+static void stats_tx_request(unsigned char how, char link){
+    if(stats_tx == STATS_TX_IDLE){
+        stats_tx_how  = how;
+        stats_tx_link = link;
+        stats_tx      = STATS_TX_PENDING;
+        return;
     }
-    while(port > 0){
-        digits[d++] = (char)('0' + (port % 10));
-        port /= 10;
+    // One latched request; the latest link gets it, a reset is kept.
+    if(!stats_tx_next || how == STATS_REPORT_RESET){
+        stats_tx_next_how = how;
     }
-    // Append digits in correct order
-    while(d > 0){
-        AT_CIPSERVER[i++] = digits[--d];
+    stats_tx_next_link = link;
+    stats_tx_next      = TRUE;
+}
+
+static void stats_tx_done(void){
+    stats_tx = STATS_TX_IDLE;
+    if(stats_tx_next){
+        stats_tx_next = FALSE;
+        stats_tx_request(stats_tx_next_how, stats_tx_next_link);
+    }
+}
+
+static void stats_tx_tick(void){
+    char  cipsend[24];
+    char *p;
+    char *end;
+    int   i;
+    const char prefix[] = "AT+CIPSEND=";
+
+    switch(stats_tx){
+        case STATS_TX_PENDING:
+            if(UCA0IE & UCTXIE){
+                return;                     // Previous AT command still going out
+            }
+            end = Stats_Format(stats_tx_line, stats_tx_how);
+            for(i = 0, p = cipsend; prefix[i] != SERIAL_NULL; i++){
+                *p++ = prefix[i];
+            }
+            *p++ = stats_tx_link;
+            *p++ = ',';
+            p = Fmt_Dec(p, (unsigned int)(end - stats_tx_line), 0, FMT_SPACE);
+            *p++ = SERIAL_CR;
+            *p++ = SERIAL_LF;
+            *p   = SERIAL_NULL;
+            Serial_Transmit(cipsend);
+            stats_tx_wait = BEGINNING;
+            stats_tx      = STATS_TX_PROMPT;
+            break;
+
+        case STATS_TX_PROMPT:
+            for(i = 0; i < IOT_DATA_LINES; i++){
+                if(IOT_Data[i][0] == '>'){
+                    IOT_Data[i][0] = SERIAL_NULL;
+                    Serial_Transmit(stats_tx_line);
+                    stats_tx_done();
+                    return;
+                }
+            }
+            if(++stats_tx_wait > IOT_TIMEOUT_GENERIC){
+                USB_transmit_string("ERR: no CIPSEND prompt\r\n");
+                stats_tx_done();
+            }
+            break;
+
+        default:
+            break;
     }
-    AT_CIPSERVER[i++] = SERIAL_CR;
-    AT_CIPSERVER[i++] = SERIAL_LF;
-    AT_CIPSERVER[i]   = SERIAL_NULL;
 }
 
 //==============================================================================
@@ -134,6 +219,11 @@ static void build_cipserver_string(void){
 //==============================================================================
 void IOT_State_Machine(void){
 
+    if(iot_state != iot_traced){
+        iot_traced = iot_state;
+        TRACE(TR_IOT_STATE, iot_state, 0);
+    }
+
     switch(iot_state){
 
         case IOT_STATE_WAIT_READY:
@@ -279,6 +369,15 @@ void IOT_State_Machine(void){
                     continue;
                 }
                 if(strstr(IOT_Data[i], "+IPD") == NULL){
+                    // Link events for the counters: "0,CONNECT" from a TCP
+                    // client, "WIFI DISCONNECT" from the access point.
+                    if(strstr(IOT_Data[i], ",CONNECT") != NULL){
+                        Stats_Inc(STAT_TCP_CONNECT);
+                        IOT_Data[i][0] = SERIAL_NULL;
+                    } else if(strstr(IOT_Data[i], "WIFI DISCONNECT") != NULL){
+                        Stats_Inc(STAT_WIFI_DROP);
+                        IOT_Data[i][0] = SERIAL_NULL;
+                    }
                     continue;
                 }
                 colon = strchr(IOT_Data[i], ':');
@@ -292,6 +391,7 @@ void IOT_State_Machine(void){
                 Parse_IPD_Command(IOT_Data[i]);
                 IOT_Data[i][0] = SERIAL_NULL;
             }
+            stats_tx_tick();
         } break;
 
         default:
@@ -348,6 +448,7 @@ static unsigned char cmd_queue_pop(char *dir, unsigned int *time_units){
 // start_cmd -- kick off one queued command: set motors + arm auto-stop timer.
 //==============================================================================
 static void start_cmd(char dir, unsigned int time_units){
+    TRACE(TR_CMD_START, dir, time_units);
     Wheels_All_Off();
 
     switch(dir){
@@ -369,21 +470,27 @@ static void start_cmd(char dir, unsigned int time_units){
             break;
         case CMD_DIR_CALIBRATE:
             // Not time-bounded; hands control to the calibration state machine.
+            Stats_Inc(STAT_CMDS);
             Calibration_Start();
             return;
         case CMD_DIR_LINE_FOLLOW:
             // time_units is in 100 ms units; Line_Follow_Start wants seconds.
+            Stats_Inc(STAT_CMDS);
             Line_Follow_Start(time_units / 10);
             return;
         case CMD_DIR_QUIT:
             // Queued quit -- also valid, same as the immediate path.
+            Stats_Inc(STAT_CMDS);
             Quit_Everything();
             return;
         default:
+            TRACE(TR_CMD_ERR, TR_ERR_BAD_DIR, dir);
+            Stats_Inc(STAT_ERR_OTHER);
             USB_transmit_string("ERR: bad dir\r\n");
             return;
     }
 
+    Stats_Inc(STAT_CMDS);
     cmd_active_dir   = dir;
     cmd_active_time  = time_units;
     cmd_remaining_ms = time_units * CMD_TIME_UNIT_MS;
@@ -404,6 +511,8 @@ static unsigned char parse_one_cmd(const char *ptr,
     }
     if(ptr[1] != CMD_PIN_0 || ptr[2] != CMD_PIN_1 ||
        ptr[3] != CMD_PIN_2 || ptr[4] != CMD_PIN_3){
+        TRACE(TR_CMD_ERR, TR_ERR_BAD_PIN, 0);
+        Stats_Inc(STAT_ERR_PIN);
         USB_transmit_string("ERR: bad PIN\r\n");
         return 0;
     }
@@ -411,6 +520,8 @@ static unsigned char parse_one_cmd(const char *ptr,
     for(i = 0; i < CMD_TIME_DIGITS; i++){
         char c = ptr[CMD_TIME_OFFSET + i];
         if(c < '0' || c > '9'){
+            TRACE(TR_CMD_ERR, TR_ERR_BAD_TIME, c);
+            Stats_Inc(STAT_ERR_TIME);
             USB_transmit_string("ERR: bad time\r\n");
             return 0;
         }
@@ -438,11 +549,18 @@ void Parse_IPD_Command(char *line){
     char           dir;
     unsigned int   time_units;
     unsigned int   queued_count = 0;
+    char           link;
 
     USB_transmit_string("IPD!\r\n");
 
+    // "+IPD,<link>,<len>:" -- CIPMUX=1, so the link id comes first.
+    payload = strstr(line, "+IPD,");
+    link    = (payload != NULL) ? payload[5] : '0';
+
     payload = strchr(line, ':');
     if(payload == NULL){
+        TRACE(TR_CMD_ERR, TR_ERR_NO_COLON, 0);
+        Stats_Inc(STAT_ERR_OTHER);
         USB_transmit_string("ERR: +IPD no ':'\r\n");
         return;
     }
@@ -459,6 +577,7 @@ void Parse_IPD_Command(char *line){
             // Q is a control command -- execute IMMEDIATELY, do not queue.
             // Clears any queue we've already built up in this same payload too.
             if(dir == CMD_DIR_QUIT){
+                Stats_Inc(STAT_CMDS);
                 Quit_Everything();
                 cmd_q_head = cmd_q_tail;   // flush any pending
                 p += CMD_PAYLOAD_LEN;
@@ -466,7 +585,50 @@ void Parse_IPD_Command(char *line){
                 continue;
             }
 
+            // PID gain updates are also immediate -- they must land while
+            // line-follow is running, not after it finishes.
+            if(dir == CMD_DIR_SET_KP || dir == CMD_DIR_SET_KI ||
+               dir == CMD_DIR_SET_KD){
+                Stats_Inc(STAT_CMDS);
+                Line_Follow_Set_Gain(dir, time_units);
+                p += CMD_PAYLOAD_LEN;
+                if(queued_count == 0){
+                    queued_count = 1;      // suppress "ERR: no cmd"
+                }
+                continue;
+            }
+
+            // Counter report -- answered on the link this +IPD came in on.
+            if(dir == CMD_DIR_STATS){
+                stats_tx_request((time_units == STATS_REPORT_RESET)
+                                 ? STATS_REPORT_RESET : STATS_REPORT, link);
+                p += CMD_PAYLOAD_LEN;
+                if(queued_count == 0){
+                    queued_count = 1;      // suppress "ERR: no cmd"
+                }
+                continue;
+            }
+
+            // Rail profile changes likewise apply mid-run.
+            if(dir == CMD_DIR_DAC_PROFILE){
+                if(time_units <= 0xFF && DAC_Seq_Start((unsigned char)time_units)){
+                    Stats_Inc(STAT_CMDS);
+                    USB_transmit_string("DAC profile\r\n");
+                } else {
+                    TRACE(TR_CMD_ERR, TR_ERR_BAD_PROFILE, time_units);
+                    Stats_Inc(STAT_ERR_OTHER);
+                    USB_transmit_string("ERR: bad profile\r\n");
+                }
+                p += CMD_PAYLOAD_LEN;
+                if(queued_count == 0){
+                    queued_count = 1;      // suppress "ERR: no cmd"
+                }
+                continue;
+            }
+
             if(!cmd_queue_push(dir, time_units)){
+                TRACE(TR_CMD_ERR, TR_ERR_QUEUE_FULL, queued_count);
+                Stats_Inc(STAT_ERR_QUEUE);
                 USB_transmit_string("ERR: queue full\r\n");
                 break;
             }
@@ -477,7 +639,10 @@ void Parse_IPD_Command(char *line){
         }
     }
 
+    TRACE(TR_IPD, 0, queued_count);
     if(queued_count == 0){
+        TRACE(TR_CMD_ERR, TR_ERR_NO_CMD, 0);
+        Stats_Inc(STAT_ERR_OTHER);
         USB_transmit_string("ERR: no cmd\r\n");
         return;
     }
@@ -523,6 +688,7 @@ void Vehicle_Cmd_Tick(void){
         return;
     }
     if(cmd_remaining_ms <= TB0_TICK_MS){
+        TRACE(TR_CMD_DONE, cmd_active_dir, 0);
         cmd_remaining_ms = BEGINNING;
         cmd_active_dir   = SERIAL_NULL;
         Wheels_All_Off();
@@ -537,6 +703,8 @@ void Vehicle_Cmd_Tick(void){
 //   Line 2: "IP address"
 //   Line 3: first two octets   (e.g. "10.152    ")
 //   Line 4: last two octets    (e.g. "15.74     ")
+// A new screen after a run or ^Q, so every cell is rewritten rather than
+// diffed -- anything left wrong on the glass is cleared here.
 //==============================================================================
 void Display_Network_Info(void){
     unsigned int i;
@@ -545,15 +713,18 @@ void Display_Network_Info(void){
     char hi[11] = "          ";
     char lo[11] = "          ";
 
+    Display_Invalidate();
+
     // SSID line
     for(i = 0; i < 10; i++){
         display_line[LCD_LINE1_SSID][i] =
             (car_ssid[i] != SERIAL_NULL) ? car_ssid[i] : ' ';
     }
     display_line[LCD_LINE1_SSID][10] = SERIAL_NULL;
+    Display_Mark(LCD_LINE_BIT(LCD_LINE1_SSID));
 
     // Static label
-    strcpy(display_line[LCD_LINE2_LABEL], "IP address");
+    Display_Line(LCD_LINE2_LABEL, "IP address");
 
     // Split car_ip on the second '.'  -> hi = "AAA.BBB", lo = "CCC.DDD"
     dot_count = 0;
@@ -587,8 +758,6 @@ void Display_Network_Info(void){
         }
     }
 
-    strcpy(display_line[LCD_LINE3_IP_HI], hi);
-    strcpy(display_line[LCD_LINE4_IP_LO], lo);
-
-    display_changed = TRUE;
+    Display_Line(LCD_LINE3_IP_HI, hi);
+    Display_Line(LCD_LINE4_IP_LO, lo);
 }
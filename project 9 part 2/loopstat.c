@@ -0,0 +1,222 @@
+//==============================================================================
+// File:        loopstat.c
+// Description: Main-loop cycle accounting -- see loopstat.h.
+//
+//              Report (^L), one line per main-loop pass:
+//                Loop cycles @ 8 MHz, 123456 passes
+//                task            max    worst |  <128  <256 ...  more
+//                IOT_Proc        812      301 |  9120 11873 ...     0
+//                ...
+//                PASS          41230    41230 |     0     0 ...     0
+//              "max" is the longest single call, "worst" the task's share
+//              of the longest pass (PASS: the longest pass itself).
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "msp430.h"
+#include "functions.h"
+#include "macros.h"
+#include "ports.h"
+#include "serial.h"
+#include "fmt.h"
+#include "loopstat.h"
+
+#define LOOP_LINE_LEN       (128)
+#define LOOP_HIST_MAX       (0xFFFFu)
+#define LOOP_REP_HEADER     (0)
+#define LOOP_REP_LEGEND     (1)
+#define LOOP_REP_FIRST_SLOT (2)
+#define LOOP_REP_IDLE       (0xFF)
+
+typedef struct {
+    unsigned int  hist[LOOP_HIST_BINS];
+    unsigned long max;              // Longest single call
+    unsigned long worst;            // Share of the longest pass
+} loop_slot_t;
+
+static loop_slot_t   loop_slot[LOOP_SLOTS];
+static unsigned long loop_cur[LOOP_TASKS];  // This pass, per task
+static unsigned long loop_passes;
+static unsigned long t_pass;
+static unsigned long t_mark;
+static unsigned char loop_started = FALSE;
+
+static volatile unsigned char rep_request = FALSE;
+static unsigned char          rep_line    = LOOP_REP_IDLE;
+static char                   rep_buf[LOOP_LINE_LEN];
+
+static const char * const loop_name[LOOP_SLOTS] = {
+    "IOT_Proc  ", "IOT_State ", "Calibrate ", "LineFollow",
+    "VehicleQ  ", "Display   ", "PASS      "
+};
+
+// Column heads line up with "<name> <max:8> <worst:8> |" + 6-wide bins
+static const char loop_legend[] =
+    "task            max    worst |"
+    "  <128  <256  <512   <1k   <2k   <4k   <8k  <16k  <32k  <64k <128k  more\r\n";
+
+//==============================================================================
+// Function: Cycles_Now
+// Description: 32-bit cycle count from TB2R and cycle_hi.  If TB2 wraps
+//              between the two reads, the overflow ISR runs before the next
+//              instruction and changes cycle_hi, so the pair is re-read.
+//              Needs GIE -- main loop only.
+//==============================================================================
+unsigned long Cycles_Now(void){
+    unsigned int hi;
+    unsigned int lo;
+
+    do {
+        hi = cycle_hi;
+        lo = TB2R;
+    } while(hi != cycle_hi);
+
+    return ((unsigned long)hi << 16) | lo;
+}
+
+//------------------------------------------------------------------------------
+// loop_record -- one sample into a slot's histogram and max
+//------------------------------------------------------------------------------
+static void loop_record(unsigned char s, unsigned long cycles){
+    unsigned long v = cycles >> LOOP_HIST_SHIFT;
+    unsigned char b = 0;
+
+    while(v && b < LOOP_HIST_BINS - 1){
+        v >>= 1;
+        b++;
+    }
+    if(loop_slot[s].hist[b] != LOOP_HIST_MAX){
+        loop_slot[s].hist[b]++;
+    }
+    if(cycles > loop_slot[s].max){
+        loop_slot[s].max = cycles;
+    }
+}
+
+static void loop_clear(void){
+    unsigned char s;
+    unsigned char b;
+
+    for(s = 0; s < LOOP_SLOTS; s++){
+        for(b = 0; b < LOOP_HIST_BINS; b++){
+            loop_slot[s].hist[b] = 0;
+        }
+        loop_slot[s].max   = 0;
+        loop_slot[s].worst = 0;
+    }
+    loop_passes = 0;
+}
+
+//------------------------------------------------------------------------------
+// loop_report_line -- send report line rep_line (polled, ~10 ms at 115,200)
+//------------------------------------------------------------------------------
+static void loop_report_line(void){
+    char         *p = rep_buf;
+    const char   *k;
+    unsigned char s;
+    unsigned char b;
+
+    if(rep_line == LOOP_REP_HEADER){
+        USB_transmit_string("\r\nLoop cycles @ ");
+        p = Fmt_Dec(p, MCLK_FREQ_MHZ, 0, FMT_SPACE);
+        for(k = " MHz, "; *k != SERIAL_NULL; k++){
+            *p++ = *k;
+        }
+        p = Fmt_Dec32(p, loop_passes, 0, FMT_SPACE);
+        *p++ = ' ';
+        *p   = SERIAL_NULL;
+        USB_transmit_string(rep_buf);
+        USB_transmit_string("passes\r\n");
+        rep_line++;
+        return;
+    }
+    if(rep_line == LOOP_REP_LEGEND){
+        USB_transmit_string(loop_legend);
+        rep_line++;
+        return;
+    }
+
+    s = rep_line - LOOP_REP_FIRST_SLOT;
+    for(b = 0; loop_name[s][b] != SERIAL_NULL; b++){
+        *p++ = loop_name[s][b];
+    }
+    *p++ = ' ';
+    p = Fmt_Dec32(p, loop_slot[s].max, 8, FMT_SPACE);
+    *p++ = ' ';
+    p = Fmt_Dec32(p, loop_slot[s].worst, 8, FMT_SPACE);
+    *p++ = ' ';
+    *p++ = '|';
+    for(b = 0; b < LOOP_HIST_BINS; b++){
+        p = Fmt_Dec(p, loop_slot[s].hist[b], 6, FMT_SPACE);
+    }
+    *p++ = SERIAL_CR;
+    *p++ = SERIAL_LF;
+    *p   = SERIAL_NULL;
+    USB_transmit_string(rep_buf);
+
+    if(++rep_line >= LOOP_REP_FIRST_SLOT + LOOP_SLOTS){
+        loop_clear();                       // ^L starts a new set
+        rep_line = LOOP_REP_IDLE;
+    }
+}
+
+//==============================================================================
+// Function: Loop_Stats_Begin
+// Description: Top of the main loop.  Closes the previous pass (PASS slot;
+//              a new longest pass also captures every task's share), sends
+//              one report line if ^L is pending, then starts timing.
+//==============================================================================
+void Loop_Stats_Begin(void){
+    unsigned long dt;
+    unsigned char i;
+
+    if(loop_started){
+        dt = Cycles_Now() - t_pass;
+        if(dt > loop_slot[LOOP_PASS].max){
+            for(i = 0; i < LOOP_TASKS; i++){
+                loop_slot[i].worst = loop_cur[i];
+            }
+            loop_slot[LOOP_PASS].worst = dt;
+        }
+        loop_record(LOOP_PASS, dt);
+        loop_passes++;
+    }
+
+    if(rep_request){
+        rep_request = FALSE;
+        rep_line    = LOOP_REP_HEADER;
+    }
+    if(rep_line != LOOP_REP_IDLE){
+        loop_report_line();                 // Not counted: timing restarts below
+    }
+
+    loop_started = TRUE;
+    t_pass = Cycles_Now();
+    t_mark = t_pass;
+}
+
+//==============================================================================
+// Function: Loop_Stats_Mark
+// Description: After a task -- charges the cycles since the previous mark to
+//              it.  The bookkeeping itself is left out of the next task
+//              (t_mark is re-read) but stays in the PASS total.
+//==============================================================================
+void Loop_Stats_Mark(unsigned char task){
+    unsigned long dt = Cycles_Now() - t_mark;
+
+    loop_cur[task] = dt;
+    loop_record(task, dt);
+    t_mark = Cycles_Now();
+}
+
+//==============================================================================
+// Function: Loop_Stats_Request
+// Description: ^L -- queue a report; sent from the main loop.
+//==============================================================================
+void Loop_Stats_Request(void){
+    rep_request = TRUE;
+}
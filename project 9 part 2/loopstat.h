@@ -0,0 +1,51 @@
+//==============================================================================
+// File:        loopstat.h
+// Description: Main-loop cycle accounting (Project 9 Part 2).
+//
+//              Timer B2 runs free at SMCLK (8 MHz, one count per cycle) and
+//              its overflow ISR extends it to 32 bits (cycle_hi, timers.c).
+//              The main loop calls Loop_Stats_Begin at the top of every pass
+//              and Loop_Stats_Mark after each task; every mark charges the
+//              cycles since the previous one to that task.  Per task, and
+//              for the whole pass, RAM holds (cleared at reset and by ^L):
+//                - a log2 histogram: bin 0 < 128 cycles, bin k holds
+//                  2^(k+6) .. 2^(k+7)-1, the last bin everything >= 128k
+//                  (16 ms); counts stop at 65535
+//                - the longest call
+//                - its share of the longest pass
+//
+//              ^L on the PC backchannel prints the tables and starts a new
+//              set.  The report goes out one line per pass from
+//              Loop_Stats_Begin, and those passes are not counted.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef LOOPSTAT_H_
+#define LOOPSTAT_H_
+
+// Tasks, in main-loop order
+#define LOOP_IOT_PROCESS    (0)     // IOT_Process
+#define LOOP_IOT_STATE      (1)     // IOT_State_Machine
+#define LOOP_CALIBRATION    (2)     // Calibration_Tick
+#define LOOP_LINE_FOLLOW    (3)     // Line_Follow_Tick
+#define LOOP_VEHICLE_QUEUE  (4)     // Process_Vehicle_Queue
+#define LOOP_DISPLAY        (5)     // Display_Process
+#define LOOP_TASKS          (6)
+#define LOOP_PASS           (LOOP_TASKS)    // Whole iteration
+#define LOOP_SLOTS          (LOOP_TASKS + 1)
+
+#define LOOP_HIST_BINS      (12)
+#define LOOP_HIST_SHIFT     (7)     // Bin 0 = below 2^7 cycles
+
+extern volatile unsigned int cycle_hi;      // TB2 overflows (timers.c)
+
+unsigned long Cycles_Now(void);             // Main loop only (needs GIE)
+void          Loop_Stats_Begin(void);
+void          Loop_Stats_Mark(unsigned char task);
+void          Loop_Stats_Request(void);     // ^L, from the UCA1 ISR
+
+#endif /* LOOPSTAT_H_ */
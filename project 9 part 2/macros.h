@@ -35,6 +35,17 @@
 // 5 x 200 ms = 1.0 second total debounce window
 #define DEBOUNCE_THRESHOLD  (5)
 
+//------------------------------------------------------------------------------
+// Timer B1 -- line-follow control clock, up mode, SMCLK/8 = 1 MHz
+//   Each CCR0 interrupt starts one A2/A3/A5 ADC sweep; Line_Follow_Tick runs
+//   once per completed sweep, so controller samples are exactly
+//   1 / LF_CTRL_HZ apart no matter how busy the main loop is.
+//------------------------------------------------------------------------------
+#define LF_CTRL_HZ          (200)    // 5 ms control period
+#define LF_CTRL_MS          (1000 / LF_CTRL_HZ)
+#define TB1_CLK_HZ          (1000000UL)
+#define TB1CCR0_INTERVAL    ((unsigned int)(TB1_CLK_HZ / LF_CTRL_HZ - 1))
+
 // Time_Sequence wrap value (250 x 200 ms = 50 seconds)
 #define TIME_SEQ_MAX        (250)
 
@@ -56,22 +67,26 @@
 #define BAUD_9600    (1)
 
 //--------------------------------------------------------------
-// IOT Ring Buffer size
+// IOT Ring Buffer size -- powers of two; indices wrap with the mask.
+// The IOT ring holds IOT_RING_SIZE - 1 bytes (one slot tells full from
+// empty); at 115,200 baud that is ~11 ms of ESP32 output between
+// IOT_Process calls.
 //--------------------------------------------------------------
 #define IOT_RING_SIZE   (128)
+#define IOT_RING_MASK   (IOT_RING_SIZE - 1)
 #define USB_RING_SIZE   (128)
+#define USB_RING_MASK   (USB_RING_SIZE - 1)
 
 //------------------------------------------------------------------------------
-// UCA0 register values for each baud rate (BRCLK = SMCLK = 8 MHz)
-//
-// BRCLK  Baud    UCOS16  UCBRx  UCFx  UCSx   BRW   MCTLW
-// 8 MHz   9600     1      52     1    0x49    52    0x4911
-// 8 MHz  115200    1       4     5    0x55     4    0x5551
+// System clock (Init_Clocks: MCLK = SMCLK = DCO).  The UART BRW / MCTLW
+// values, the LCD SPI rate and delays, the motor PWM period (SMCLK_HZ) and
+// the trace / loop-statistics clock are derived from it at compile time.
+// Init_Clocks and the Timer B0 / B1 dividers are still written for 8 MHz;
+// clocks.c stops the build on any other value.
 //------------------------------------------------------------------------------
-#define BAUD_9600_BRW       (52)
-#define BAUD_9600_MCTLW     (0x4911)
-#define BAUD_115200_BRW     (4)
-#define BAUD_115200_MCTLW   (0x5551)
+#define MCLK_FREQ_MHZ       (8)
+#define UART_BAUD_9600      (9600UL)
+#define UART_BAUD_115200    (115200UL)
 
 //------------------------------------------------------------------------------
 // Special characters used in serial framing
@@ -87,6 +102,11 @@
 #define FRAM_CMD_PING       ('^')    // ^^  -> FRAM responds "I'm here"
 #define FRAM_CMD_FAST       ('F')    // ^F  -> switch UCA0 to 115,200 baud
 #define FRAM_CMD_SLOW       ('S')    // ^S  -> switch UCA0 to 9,600 baud
+#define FRAM_CMD_LOOP       ('L')    // ^L  -> main-loop cycle report (loopstat.c)
+#define FRAM_CMD_MEM        ('M')    // ^M  -> stack size / high-water / headroom
+#define FRAM_CMD_TRACE      ('T')    // ^T  -> dump the event trace (trace.c)
+#define FRAM_CMD_STATS      ('?')    // ^?  -> STATS counter line (stats.h)
+#define FRAM_CMD_STATS_CLR  ('!')    // ^!  -> STATS line, then zero the counters
 
 //--------------------------------------------------------------
 // IOT Control Pin Defines
@@ -124,6 +144,12 @@
 #define LCD_LINE3_IP_HI     (2)   // display_line[2]: first two IP octets
 #define LCD_LINE4_IP_LO     (3)   // display_line[3]: last two IP octets
 
+// Dirty-line masks for Display_Mark (display.c).  Bit n = display_line[n].
+#define LCD_LINES           (4)
+#define LCD_COLS            (10)
+#define LCD_LINE_BIT(n)     ((unsigned char)(1u << (n)))
+#define LCD_ALL_LINES       (0x0F)
+
 //------------------------------------------------------------------------------
 // IOT response parse buffer -- multi-line scratch space populated by IOT_Process
 // Each row holds one CR/LF-terminated line from the ESP32 (null-terminated).
@@ -133,9 +159,10 @@
 
 //------------------------------------------------------------------------------
 // IOT AT-command transmit buffer -- staged by Serial_Transmit, drained by TX ISR.
-// Sized large enough for "AT+CIPSERVER=1,65535\r\n" + null.
+// Sized for the longest payload sent after AT+CIPSEND: the STATS line
+// (STATS_LINE_LEN in stats.h).
 //------------------------------------------------------------------------------
-#define IOT_TX_BUF_SIZE     (40)
+#define IOT_TX_BUF_SIZE     (128)
 
 //------------------------------------------------------------------------------
 // Vehicle command protocol  ^<PIN><dir><time>
@@ -159,6 +186,11 @@
 #define CMD_DIR_QUIT        ('Q')   // ^1234Q0000 -- abort current cmd + queue
 #define CMD_DIR_CALIBRATE   ('C')   // ^1234C0000 -- run white/black calibration
 #define CMD_DIR_LINE_FOLLOW ('N')   // ^1234N<time> -- liNe follow for time
+#define CMD_DIR_SET_KP      ('P')   // ^1234P<q8>   -- set line-follow Kp (Q8.8)
+#define CMD_DIR_SET_KI      ('I')   // ^1234I<q8>   -- set line-follow Ki (Q8.8)
+#define CMD_DIR_SET_KD      ('D')   // ^1234D<q8>   -- set line-follow Kd (Q8.8)
+#define CMD_DIR_DAC_PROFILE ('V')   // ^1234V000n   -- play motor rail profile n
+#define CMD_DIR_STATS       ('?')   // ^1234?000n   -- STATS reply; n = 1 also resets
 #define CMD_TIME_UNIT_MS    (100)      // each time-unit digit = 100 ms
 #define CMD_PAYLOAD_LEN     (10)       // ^ + 4 PIN + 1 dir + 4 time
 
@@ -172,43 +204,103 @@
 #define CAL_SAMPLE_DELAY_MS         (1000) // Hold each surface ~1 s after SW1
 
 //------------------------------------------------------------------------------
-// Line-follow PD control (ported verbatim from working Project_7/Follow_Line):
-//   correction = (KP*err + KD*d_err) / PD_SCALE_DIVISOR
+// Line-follow PID control (pid.c, Q8.8 gains, 256 = 1.0):
+//   correction = PID(err = ADC_L - ADC_R)
 //   left  = BASE - correction
 //   right = BASE + correction
-// When BOTH sensors are OFF the line: drive in REVERSE at REVERSE_SPEED to
-// reacquire (P7's key behaviour -- prevents the car drifting off forever).
-//------------------------------------------------------------------------------
-// Line-follow runs with Project_7's ORIGINAL pin and algorithm config.  The
-// line-follow state switches the Port 6 pin layout on entry and restores it
-// on exit so that F/B/R/L commands (which use the current P9P2 mapping)
-// are unaffected.  Direct TB3CCRn writes are used during line-follow so
-// the speed macros in ports.h don't interfere.
-//
-// Project_7 motor wiring (this car):
-//   CCR1 -> P6.1 RIGHT_FORWARD  (dead on this car; writes are harmless)
-//   CCR2 -> P6.2 LEFT_FORWARD
-//   CCR3 -> P6.3 RIGHT_REVERSE
-//   CCR4 -> P6.4 LEFT_REVERSE
-//   P6.5 is GPIO input during line-follow, TB3.5 output otherwise
-//
-// Project_7 PD tuning (verbatim from the working reference):
-#define P7_KP                       (1)
-#define P7_KD                       (5)
-#define P7_PD_DIVISOR               (10)
-#define P7_BASE_SPEED               (20000) // Nominal forward PWM during follow
-#define P7_MAX_SPEED                (35000) // Per-wheel clamp
-#define P7_REVERSE_SPEED            (15000) // Reverse-reacquire PWM
-#define P7_SPIN_SPEED               (20000) // Spin turn PWM (align phase)
+// When BOTH sensors are OFF the line: lost-line search (LF_REC_* below).
+// Motors are driven through motor.h on the same channel map as F/B/R/L.
+//------------------------------------------------------------------------------
+// PID tuning.  Defaults reproduce the old Project_7 PD law
+// (KP=1, KD=5, divisor 10 -> 0.1 / 0.5) plus a small integral term to remove
+// the steady-state offset on long curves.  All three gains can be changed
+// live over TCP with ^1234P<q8>, ^1234I<q8>, ^1234D<q8> (4-digit raw Q8.8,
+// e.g. ^1234P0026 -> Kp = 26/256 = 0.10).  Ki and Kd are per control
+// period (1 / LF_CTRL_HZ).
+#define LF_PID_KP_Q8                (26)    // 0.10
+#define LF_PID_KI_Q8                (1)     // 0.004 per sample
+#define LF_PID_KD_Q8                (128)   // 0.50
+#define LF_PID_D_SHIFT              (1)     // Derivative low-pass: 1/2 new sample
+#define LF_PID_INTEG_LIMIT          PWM_REF(1600)  // |I term| clamp, 16 %
+#define LF_PID_OUT_LIMIT            PWM_REF(6000)  // |correction| clamp, 60 %
+#define P7_BASE_REF                 PWM_REF(4000)  // P7_BASE_SPEED in PID units
+#define P7_BASE_SPEED               PWM_DUTY(4000) // Nominal forward, 40 %
+#define P7_MAX_SPEED                PWM_DUTY(7000) // Per-wheel clamp, 70 %
+#define P7_SPIN_SPEED               PWM_DUTY(4000) // Spin turn (align phase)
+
+// Speed governor (LF_FOLLOW).  Turn demand is the largest of the filtered
+// |error|, the filtered |correction| (left/right differential) and a
+// look-ahead on the PID's filtered error rate, each scaled to 0..256.  The
+// target speed runs from LF_GOV_MAX_SPEED (straight, demand 0) down to
+// LF_GOV_MIN_SPEED (demand 256); speed rises by at most LF_GOV_ACCEL_STEP and
+// falls by at most LF_GOV_BRAKE_STEP per control period (Q8 counts, so a step
+// under one count still adds up at high MOTOR_PWM_HZ).  The PID correction
+// is scaled by speed / P7_BASE_REF so steering authority tracks speed (and
+// lands in this period's counts).
+// Off by default: in the host sim (linesim, 200 runs) it has not beaten the
+// fixed 40 % on lap time at both 160 Hz and 20 kHz PWM without losing the
+// line more often, and no MAX/MIN/look-ahead/brake setting tried did either.
+#ifndef LF_GOV_ENABLE
+#define LF_GOV_ENABLE               (0)     // 0 = fixed P7_BASE_SPEED
+#endif
+#define LF_GOV_HEADROOM             PWM_DUTY(1000) // Outer-wheel room under the clamp
+#define LF_GOV_MAX_SPEED            (P7_MAX_SPEED - LF_GOV_HEADROOM) // Straight, 60 %
+#define LF_GOV_MIN_SPEED            PWM_DUTY(3600) // Tightest-curve speed
+#define LF_GOV_FILTER_SHIFT         (3)     // Demand low-pass: 1/8 per period
+#define LF_GOV_LOOKAHEAD            (4)     // Weight of error rate vs error
+#define LF_GOV_ACCEL_STEP           PWM_STEP_Q8(10) // Per period up   (1.0 s base to max)
+#define LF_GOV_BRAKE_STEP           PWM_STEP_Q8(80) // Per period down (0.15 s max to min)
+
+// Lost-line recovery (LF_RECOVER).  Entered when both sensors drop below
+// threshold during LF_FOLLOW; every phase turns toward the side the error
+// last pointed at.
+//   1. Sweep: LF_REC_SWINGS in-place pivots, alternating direction, swing k
+//      lasting (k + 1) * LF_REC_SWING_PERIODS -- so the heading walks
+//      +1, -1, +2, -2, +3 units out from where the line was lost.
+//   2. Spiral: outer wheel at LF_REC_SPIRAL_SPEED, inner wheel opening up
+//      by LF_REC_SPIRAL_GROW (Q8 counts) per period (ever-wider circle).
+//   3. Give up after LF_REC_TIMEOUT periods in total: stop and end the run.
+// Times are in control periods (LF_CTRL_MS each).
+#define LF_REC_SPIN_SPEED           PWM_DUTY(4000) // Sweep pivot
+#define LF_REC_SWING_PERIODS        (30)    // 150 ms -- first swing
+#define LF_REC_SWINGS               (5)     // Sweep bound (2.25 s total)
+#define LF_REC_SPIRAL_SPEED         PWM_DUTY(4000) // Spiral outer wheel
+#define LF_REC_SPIRAL_GROW          PWM_STEP_Q8(4) // Inner wheel per period (~5 s)
+#define LF_REC_TIMEOUT              (1600)  // 8 s, then give up
 
 // Speeds used by wheels.c for Forward_On/Reverse_On/Spin_CW/CCW (F/B/R/L
-// commands).  These run on the P9P2 pin mapping (CCR2-CCR5) -- completely
-// independent of the Project_7 line-follow values above.
-#define FOLLOW_SPEED                (25000)
-#define SPIN_SPEED                  (20000)
-#define REVERSE_SPEED               (15000) // currently unused by wheels.c but
+// commands) -- independent of the line-follow values above.
+#define FOLLOW_SPEED                PWM_DUTY(5000)
+#define SPIN_SPEED                  PWM_DUTY(4000)
+#define REVERSE_SPEED               PWM_DUTY(3000) // currently unused by wheels.c but
                                              // left defined for any future caller
 
+// Drive slew limits (motor.c), in duty basis points per second.  Applied
+// once per Timer B1 control period, so the per-period step is rate /
+// LF_CTRL_HZ (whole counts; motor.c stops the build if that rounds to 0).
+// F/B/R/L, calibration and lease-expiry stops only; line follow and ^Q
+// drive the wheels directly.
+#define MOTOR_ACCEL_RATE            (50000L)  // 0 -> FOLLOW_SPEED in 100 ms
+#define MOTOR_DECEL_RATE            (100000L) // FOLLOW_SPEED -> 0 in 50 ms
+#define MOTOR_ACCEL_STEP            PWM_DUTY(MOTOR_ACCEL_RATE / LF_CTRL_HZ)
+#define MOTOR_DECEL_STEP            PWM_DUTY(MOTOR_DECEL_RATE / LF_CTRL_HZ)
+
+// H-bridge dead time (motor.c): no leg's pulse runs into the last
+// MOTOR_DEAD_COUNTS of a TB3 period, so on a reversal the old leg is low
+// this long before the new one rises at the period start.  Bridge turn-off
+// plus margin; 2 us is 16 counts of top duty (0.03 % at 160 Hz, 4 % at 20 kHz).
+#ifndef MOTOR_DEAD_TIME_US
+#define MOTOR_DEAD_TIME_US          (2UL)
+#endif
+#define MOTOR_DEAD_COUNTS           ((long)(SMCLK_HZ / 1000000UL * MOTOR_DEAD_TIME_US))
+
+// Motor arbiter leases (motor.c), in control periods.  Line-follow renews
+// its request every period, so a main loop stalled longer than
+// MOTOR_LEASE_LINE coasts the car instead of holding the last command.
+// ^Q keeps every other source locked out for MOTOR_LEASE_ESTOP.
+#define MOTOR_LEASE_LINE            (10)    // 50 ms
+#define MOTOR_LEASE_ESTOP           (40)    // 200 ms
+
 //------------------------------------------------------------------------------
 // Line-follow anti-jitter knobs.
 //   LF_REVERSE_REACQUIRE -- 1 = enable the "both sensors off line -> reverse to
@@ -251,11 +343,30 @@
 
 //------------------------------------------------------------------------------
 // Timer B3 -- hardware PWM for motors (SMCLK = 8 MHz, no dividers)
-//   WHEEL_PERIOD_VAL = 50000 cycles -> ~6.25 ms period -> ~160 Hz PWM
-//   FOLLOW_SPEED / SPIN_SPEED defined above with the line-follow constants
-//   so they match Project_7 (FOLLOW_SPEED=25000, SPIN_SPEED=20000).
-//------------------------------------------------------------------------------
-#define WHEEL_PERIOD_VAL    (50000)
+//   WHEEL_PERIOD_VAL = SMCLK_HZ / MOTOR_PWM_HZ counts.  160 Hz (50000) is
+//   the Project 7 setting; 20000 Hz (400 counts) is out of earshot with far
+//   less current ripple, at 0.25 % duty resolution.
+//   Every motor speed in this file is a duty fraction in basis points
+//   (1/100 %) scaled to the period at compile time.  The results are long
+//   so a negated speed (reverse, for Motor_Set) stays negative:
+//     PWM_DUTY(bp)    -- CCR counts at this period
+//     PWM_STEP_Q8(bp) -- the same in Q8 (1/256 count), for per-period
+//                        increments too small for whole counts: the
+//                        accumulator keeps the fraction, so the rate holds
+//                        at any MOTOR_PWM_HZ (speed = accumulator >> 8)
+//     PWM_REF(bp)     -- PWM_REF_PERIOD units, which the PID and governor
+//                        demand work in so the tuned gains hold at any
+//                        MOTOR_PWM_HZ (Line_Follow_Tick rescales at the output)
+//------------------------------------------------------------------------------
+#define SMCLK_HZ            (MCLK_FREQ_MHZ * 1000000UL)
+#ifndef MOTOR_PWM_HZ
+#define MOTOR_PWM_HZ        (160UL)
+#endif
+#define WHEEL_PERIOD_VAL    ((unsigned int)(SMCLK_HZ / MOTOR_PWM_HZ))
+#define PWM_DUTY(bp)        ((long)(((unsigned long)WHEEL_PERIOD_VAL * (bp)) / 10000UL))
+#define PWM_STEP_Q8(bp)     ((long)((((unsigned long long)WHEEL_PERIOD_VAL * (bp)) << 8) / 10000ULL))
+#define PWM_REF_PERIOD      (50000UL)
+#define PWM_REF(bp)         ((unsigned int)((PWM_REF_PERIOD * (bp)) / 10000UL))
 
 //------------------------------------------------------------------------------
 // IOT state-machine timeouts (counted in main-loop iterations -- coarse)
@@ -285,4 +396,41 @@
 #define DAC_RAMP_STEP       (50)
 #define DAC_ENABLE_TICKS    (3)
 
+// Extra rail profiles (dac.c).  Ticks are Timer B0 overflows, ~0.52 s.
+#define DAC_SPRINT_CODE     (1050)  // ~7 V boost
+#define DAC_SPRINT_TICKS    (10)    // ~5 s at the boost before easing back
+#define DAC_CRUISE_CODE     (1350)  // ~5 V
+#define RAIL_CRUISE_MV      (5000)  // Regulator setpoint after CRUISE
+
+//------------------------------------------------------------------------------
+// Motor rail regulation (dac.c DAC_Regulate, from Timer1_B0_ISR).  Once a
+// rail profile has finished, the V_DAC reading (ADC A10) is low-passed and
+// every RAIL_REG_PERIODS control periods SAC3DAT moves by RAIL_DAC_STEP
+// toward the profile's setpoint (RAIL_TARGET_MV for all but CRUISE), never
+// outside RAIL_DAC_MIN..RAIL_DAC_MAX.  A reading under RAIL_FAULT_COUNTS
+// (pin floating, converter off) freezes the DAC at DAC_Adjust rather than
+// driving the rail up chasing it.
+//   RAIL_DIVIDER is the board's V_DAC divider -- measure rail / pin voltage
+//   on the car with a meter, set it here and define RAIL_DIVIDER_MEASURED.
+//   Until then the regulator stays off: with a wrong divider it holds the
+//   wrong rail.  dac.c warns if it is enabled on the placeholder.
+//------------------------------------------------------------------------------
+#ifndef RAIL_REG_ENABLE
+#define RAIL_REG_ENABLE     (0)     // 1 once RAIL_DIVIDER is measured
+#endif
+#define RAIL_TARGET_MV      (6000)  // Motor supply to hold (DAC_Limit point)
+#define RAIL_DIVIDER        (3)     // Vrail / Vpin -- placeholder, not measured
+//#define RAIL_DIVIDER_MEASURED     // Define with the metered RAIL_DIVIDER
+#define RAIL_VREF_MV        (3300)  // ADC reference (AVCC)
+#define RAIL_MV_TO_COUNTS(mv) ((unsigned int)(((mv) * 4096L) / \
+                                              (RAIL_DIVIDER * (long)RAIL_VREF_MV)))
+#define RAIL_TARGET_COUNTS  RAIL_MV_TO_COUNTS(RAIL_TARGET_MV)
+#define RAIL_DEADBAND       (6)     // Counts either side with no correction
+#define RAIL_FILTER_SHIFT   (3)     // Reading low-pass: 1/8 per period
+#define RAIL_REG_PERIODS    (20)    // 100 ms between DAC steps
+#define RAIL_DAC_STEP       (1)     // Codes per step (~5 mV of rail)
+#define RAIL_DAC_MIN        (1000)  // Highest rail allowed (~7.5 V)
+#define RAIL_DAC_MAX        (DAC_Begin) // Lowest rail allowed
+#define RAIL_FAULT_COUNTS   (200)
+
 #endif /* MACROS_H_ */
@@ -28,15 +28,18 @@
 #include "macros.h"
 #include "serial.h"
 #include "iot.h"
+#include "loopstat.h"
+#include "stackmon.h"
+#include "trace.h"
+#include "stats.h"
 
 void main(void);
 
 //==============================================================================
-// External globals (LCD.obj, timers.c)
+// External globals (LCD.c, timers.c)
 //==============================================================================
 extern char                   display_line[4][11];
 extern char                  *display[4];
-extern volatile unsigned char display_changed;
 extern volatile unsigned char update_display;
 extern volatile unsigned int  Time_Sequence;
 extern volatile char          one_time;
@@ -50,13 +53,16 @@ volatile unsigned int sw2_pressed = RESET_STATE;
 //==============================================================================
 void main(void){
 
+    Stack_Paint();             // Before anything deep runs (GIE still off)
     PM5CTL0 &= ~LOCKLPM5;     // Unlock GPIO
 
     Init_Ports();              // GPIO + IOT control pins (IOT_EN low, IOT_BOOT high)
     Init_Clocks();             // 8 MHz MCLK / SMCLK
     Init_Conditions();         // Clear display buffers + global IE
-    Init_Timers();             // Timer B0 (200 ms) + Timer B3 (motor PWM)
+    Init_Timers();             // Timer B0 (200 ms), B1 (control), B2 (cycles), B3 (PWM)
+    Trace_Init();              // TR_BOOT + reset cause into the FRAM trace
     Init_LCD();                // SPI LCD init
+    Display_Invalidate();      // Glass just reset -- next refresh rewrites all
     Init_DAC();                // SAC3 DAC -> LT1935 buck-boost -> motor 6V rail
     Init_ADC();                // 12-bit ADC for IR line detectors + thumbwheel
 
@@ -85,25 +91,35 @@ void main(void){
     P6OUT |= LCD_BACKLITE;
 
     // Splash until the state machine populates the network info
-    strcpy(display_line[LCD_LINE1_SSID],  "  ECE 306 ");
-    strcpy(display_line[LCD_LINE2_LABEL], "  P9 Pt2  ");
-    strcpy(display_line[LCD_LINE3_IP_HI], "Connecting");
-    strcpy(display_line[LCD_LINE4_IP_LO], "to NCSU...");
-    display_changed = TRUE;
+    Display_Line(LCD_LINE1_SSID,  "  ECE 306 ");
+    Display_Line(LCD_LINE2_LABEL, "  P9 Pt2  ");
+    Display_Line(LCD_LINE3_IP_HI, "Connecting");
+    Display_Line(LCD_LINE4_IP_LO, "to NCSU...");
 
     //==========================================================================
     // Main loop
     //==========================================================================
     while(ALWAYS){
 
+        Loop_Stats_Begin();       // Close last pass; ^L report line if pending
+
         IOT_Process();            // Drain UCA0 RX ring into IOT_Data[][]
+        Loop_Stats_Mark(LOOP_IOT_PROCESS);
         IOT_State_Machine();      // Drive AT command sequence / parse +IPD
+        Loop_Stats_Mark(LOOP_IOT_STATE);
         Calibration_Tick();       // Advance ^C calibration state machine
+        Loop_Stats_Mark(LOOP_CALIBRATION);
         Line_Follow_Tick();       // Update line-follow PWM from ADC
+        Loop_Stats_Mark(LOOP_LINE_FOLLOW);
         Process_Vehicle_Queue();  // Dequeue next timed motor command if any
+        Loop_Stats_Mark(LOOP_VEHICLE_QUEUE);
 
-        Display_Process();        // Refresh LCD if display_changed
+        Display_Process();        // Send changed LCD cells (200 ms)
+        Loop_Stats_Mark(LOOP_DISPLAY);
         Switches_Process();       // (no-op stub from Project 8)
+        Stack_Check();            // High-water mark every 200 ms; ^M report
+        Trace_Dump_Process();     // ^T dump, a few events per pass
+        Stats_Process();          // ^? / ^! counter line
 
         P3OUT ^= TEST_PROBE;    // Heartbeat
     }
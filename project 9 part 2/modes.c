@@ -12,9 +12,16 @@
 //     Calibration can be cancelled at any time with ^1234Q0000.
 //
 //   LINE FOLLOW (^1234N<time>):
-//     Requires calibration_done.  Drives forward with proportional-gain
-//     steering based on normalized sensor values until the cmd auto-stop
-//     fires (time * 100 ms).  ^1234Q0000 also cancels immediately.
+//     Requires calibration_done.  Drives forward with PID steering (pid.c)
+//     on the left/right sensor difference until the cmd auto-stop fires
+//     (time * 100 ms).  ^1234Q0000 also cancels immediately.
+//     Gains are live-tunable over TCP: ^1234P/I/D<q8> (see macros.h).
+//     The whole sequence steps once per ADC frame (Timer B1, LF_CTRL_HZ);
+//     frames it was too late for are counted in lf_missed_periods.
+//     With LF_GOV_ENABLE, a speed governor runs the straights faster than
+//     P7_BASE_SPEED and brakes into curves (LF_GOV_* in macros.h).  Losing the line starts a
+//     bounded sweep-then-spiral search toward the side it was last seen on
+//     (LF_REC_* in macros.h); each recovery and its duration is reported.
 //
 // Author: Thomas Gilbert (with Project 7 logic ported in)
 // Date: Mar 2026
@@ -28,7 +35,13 @@
 #include "serial.h"
 #include "iot.h"
 #include "adc.h"
+#include "pid.h"
+#include "motor.h"
+#include "fmt.h"
+#include "dac.h"
 #include "modes.h"
+#include "trace.h"
+#include "stats.h"
 
 //------------------------------------------------------------------------------
 // Globals (calibration results)
@@ -44,11 +57,19 @@ unsigned int calibration_done = 0;
 volatile unsigned char mode_cal_active  = 0;
 volatile unsigned char mode_line_active = 0;
 
+// Control periods the line-follow loop never saw (main loop too slow).
+unsigned int lf_missed_periods = 0;
+
+// Lost-line recovery statistics, reset at each ^N.
+unsigned int  lf_recoveries      = 0;   // Line re-found
+unsigned int  lf_recovery_fails  = 0;   // Search timed out
+unsigned int  lf_recovery_ms_max = 0;   // Longest successful search
+unsigned long lf_recovery_ms_sum = 0;   // Total time spent searching
+
 //------------------------------------------------------------------------------
 // External LCD globals
 //------------------------------------------------------------------------------
 extern char                  display_line[4][11];
-extern volatile unsigned char display_changed;
 
 // Switch-press flags (set by interrupts_ports.c, cleared here)
 extern volatile unsigned int sw1_pressed;
@@ -67,45 +88,23 @@ extern volatile unsigned int  cmd_active_time;
 //------------------------------------------------------------------------------
 // Forward declarations for static helpers defined later in this file.
 //------------------------------------------------------------------------------
-static void lf_enter_p7_pins(void);
-static void lf_exit_p7_pins(void);
-static void lf_motors_forward(unsigned int left, unsigned int right);
-static void lf_motors_reverse(unsigned int speed);
-static void lf_motors_stop(void);
-static void lf_motors_spin_cw(unsigned int speed);
-static void lf_motors_spin_ccw(unsigned int speed);
+static void lf_report_run(void);
 
 //------------------------------------------------------------------------------
-// Helper: write "AA:dddd  " into display_line[line_idx] where AA is a 2-char
-// label and dddd is a zero-padded 4-digit decimal value.  Pads to 10 chars.
+// Helper: write "AA:ddddd  " into display_line[line_idx] where AA is a 2-char
+// label and ddddd is a zero-padded decimal value.  Pads to 10 chars.
 //------------------------------------------------------------------------------
 static void lcd_write_value(unsigned int line_idx, const char *label, unsigned int value){
-    unsigned int tenk, thousands, hundreds, tens, ones;
-
     if(line_idx > 3) return;
 
-    // unsigned int is 16-bit on MSP430 (max 65535), so values > 99999 can't
-    // even be expressed.  Clamp to 5-digit printable range (<=65535) which
-    // comfortably covers every motor PWM we use (CCR0 = 50000).
-    // Overflow-past-65535 is impossible by type.
-
-    tenk      = value / 10000u;      value -= tenk      * 10000u;
-    thousands = value / 1000u;       value -= thousands * 1000u;
-    hundreds  = value / 100u;        value -= hundreds  * 100u;
-    tens      = value / 10u;         value -= tens      * 10u;
-    ones      = value;
-
     display_line[line_idx][0] = label[0];
     display_line[line_idx][1] = label[1];
     display_line[line_idx][2] = ':';
-    display_line[line_idx][3] = (char)('0' + tenk);
-    display_line[line_idx][4] = (char)('0' + thousands);
-    display_line[line_idx][5] = (char)('0' + hundreds);
-    display_line[line_idx][6] = (char)('0' + tens);
-    display_line[line_idx][7] = (char)('0' + ones);
+    Fmt_Dec(&display_line[line_idx][3], value, 5, FMT_ZERO);
     display_line[line_idx][8] = ' ';
     display_line[line_idx][9] = ' ';
     display_line[line_idx][10] = SERIAL_NULL;
+    Display_Mark(LCD_LINE_BIT(line_idx));
 }
 
 //------------------------------------------------------------------------------
@@ -113,7 +112,7 @@ static void lcd_write_value(unsigned int line_idx, const char *label, unsigned i
 // reset the counter to force an immediate redraw).
 //------------------------------------------------------------------------------
 static unsigned long line_dbg_cnt = 0;
-#define LINE_DBG_INTERVAL 2000
+#define LINE_DBG_INTERVAL (LF_CTRL_HZ / 4)     // control periods per redraw
 
 //------------------------------------------------------------------------------
 // Show all four calibration values on the LCD (used at end of cal)
@@ -123,7 +122,6 @@ static void lcd_show_cal_values(void){
     lcd_write_value(1, "WR", white_right);
     lcd_write_value(2, "BL", black_left);
     lcd_write_value(3, "BR", black_right);
-    display_changed = TRUE;
 }
 
 //------------------------------------------------------------------------------
@@ -138,6 +136,7 @@ static void lcd_show_cal_values(void){
 #define CAL_ST_FINISH       (6)
 
 static unsigned int cal_sub_state = CAL_ST_PROMPT_WHITE;
+static unsigned int cal_traced    = 0xFFFF;  // Last cal_sub_state traced
 static unsigned int cal_start_tick = 0;  // Time_Sequence when sampling began
 
 // Number of 200 ms timer ticks to wait after SW1 before reading the ADC
@@ -148,15 +147,17 @@ static unsigned int cal_start_tick = 0;  // Time_Sequence when sampling began
 // Quit_Everything -- ^1234Q0000 arrived.  Abort everything.
 //==============================================================================
 void Quit_Everything(void){
-    Wheels_All_Off();
-    // If line-follow was active it may have been using the Project_7 pin
-    // layout; restore P9P2 pins so F/B/R/L commands work correctly after.
-    lf_exit_p7_pins();
+    Motor_Halt();                           // no ramp-down on an abort
+    DAC_Seq_Stop();                         // and no rail profile carrying on
+    if(mode_line_active){
+        lf_report_run();
+    }
     cmd_remaining_ms = 0;
     cmd_active_dir   = SERIAL_NULL;
     cmd_active_time  = 0;
     mode_cal_active  = 0;
     mode_line_active = 0;
+    TRACE(TR_QUIT, 0, 0);
     USB_transmit_string("QUIT\r\n");
     Display_Network_Info();
 }
@@ -165,8 +166,10 @@ void Quit_Everything(void){
 // Calibration_Start -- ^1234C0000 arrived
 //==============================================================================
 void Calibration_Start(void){
-    // Stop any motion first (safety)
+    // Stop any motion first (safety) and hold still until CAL_ST_FINISH.
     Wheels_All_Off();
+    Motor_Release(MOTOR_SRC_LINE);
+    Motor_Request(MOTOR_SRC_CAL, 0, 0, MOTOR_LEASE_HOLD);
     cmd_remaining_ms = 0;
     cmd_active_dir   = SERIAL_NULL;
     mode_line_active = 0;
@@ -176,6 +179,7 @@ void Calibration_Start(void){
     ir_emitter_on = 1;
 
     cal_sub_state   = CAL_ST_PROMPT_WHITE;
+    cal_traced      = 0xFFFF;
     cal_start_tick  = Time_Sequence;
     mode_cal_active = 1;
     USB_transmit_string("CAL start\r\n");
@@ -188,15 +192,18 @@ void Calibration_Tick(void){
     if(!mode_cal_active){
         return;
     }
+    if(cal_sub_state != cal_traced){
+        cal_traced = cal_sub_state;
+        TRACE(TR_CAL_STATE, cal_sub_state, 0);
+    }
 
     switch(cal_sub_state){
 
         case CAL_ST_PROMPT_WHITE:
-            strcpy(display_line[0], " Place on ");
-            strcpy(display_line[1], "  WHITE   ");
-            strcpy(display_line[2], " Press SW1");
-            strcpy(display_line[3], "          ");
-            display_changed = TRUE;
+            Display_Line(0, " Place on ");
+            Display_Line(1, "  WHITE   ");
+            Display_Line(2, " Press SW1");
+            Display_Line(3, "          ");
             sw1_pressed     = 0;    // Consume any stale press
             cal_sub_state   = CAL_ST_WAIT_WHITE;
             break;
@@ -205,8 +212,7 @@ void Calibration_Tick(void){
             if(sw1_pressed){
                 sw1_pressed    = 0;
                 cal_start_tick = Time_Sequence;
-                strcpy(display_line[2], " Sampling ");
-                display_changed = TRUE;
+                Display_Line(2, " Sampling ");
                 cal_sub_state   = CAL_ST_SAMPLE_WHITE;
             }
             break;
@@ -223,11 +229,10 @@ void Calibration_Tick(void){
             break;
 
         case CAL_ST_PROMPT_BLACK:
-            strcpy(display_line[0], " Place on ");
-            strcpy(display_line[1], "  BLACK   ");
-            strcpy(display_line[2], " Press SW1");
-            strcpy(display_line[3], "          ");
-            display_changed = TRUE;
+            Display_Line(0, " Place on ");
+            Display_Line(1, "  BLACK   ");
+            Display_Line(2, " Press SW1");
+            Display_Line(3, "          ");
             sw1_pressed     = 0;
             cal_sub_state   = CAL_ST_WAIT_BLACK;
             break;
@@ -236,8 +241,7 @@ void Calibration_Tick(void){
             if(sw1_pressed){
                 sw1_pressed    = 0;
                 cal_start_tick = Time_Sequence;
-                strcpy(display_line[2], " Sampling ");
-                display_changed = TRUE;
+                Display_Line(2, " Sampling ");
                 cal_sub_state   = CAL_ST_SAMPLE_BLACK;
             }
             break;
@@ -265,12 +269,14 @@ void Calibration_Tick(void){
             lcd_show_cal_values();
             if((unsigned int)(Time_Sequence - cal_start_tick) >= 25){
                 mode_cal_active = 0;
+                Motor_Release(MOTOR_SRC_CAL);
                 Display_Network_Info();
             }
             break;
 
         default:
             mode_cal_active = 0;
+            Motor_Release(MOTOR_SRC_CAL);
             break;
     }
 }
@@ -283,7 +289,8 @@ void Calibration_Tick(void){
 //   LF_SEEK   -> drive forward until an IR sensor crosses its threshold
 //   LF_PAUSE  -> 1 s stop after line detection
 //   LF_ALIGN  -> 1 s spin toward the line so both sensors straddle it
-//   LF_FOLLOW -> proportional control (the "working" P7 algorithm)
+//   LF_FOLLOW -> PID steering (pid.c)
+//   LF_RECOVER -> lost-line search, back to LF_FOLLOW when found
 //==============================================================================
 
 // Sub-states for the line-follow sequence
@@ -291,13 +298,45 @@ void Calibration_Tick(void){
 #define LF_PAUSE    (1)
 #define LF_ALIGN    (2)
 #define LF_FOLLOW   (3)
+#define LF_RECOVER  (4)
 
 static unsigned char lf_sub_state  = LF_SEEK;
+static unsigned char lf_traced     = 0xFF;      // Last lf_sub_state traced
 static unsigned int  lf_phase_tick = 0;         // Time_Sequence when phase began
 static unsigned char lf_spin_cw    = 0;         // 1 = left sensor saw line first
-static int           lf_last_error = 0;         // PD state: previous error term
-// (lf_off_line_cnt and lf_diag_mode were used by the old
-// normalized-PD implementation; Project_7's port doesn't need them.)
+
+// Steering controller.  Gains live outside the PID block so a ^P/^I/^D sent
+// before the first ^N is kept; Line_Follow_Start re-inits lf_pid from them.
+static pid_ctrl_t    lf_pid;
+static unsigned int  lf_last_frame = 0;         // ADC_frame_count last consumed
+static int           lf_kp = LF_PID_KP_Q8;
+static int           lf_ki = LF_PID_KI_Q8;
+static int           lf_kd = LF_PID_KD_Q8;
+
+#if LF_GOV_ENABLE
+// Speed governor state (LF_FOLLOW only).
+static unsigned long lf_gov_q8     = (unsigned long)P7_BASE_SPEED << 8; // Q8 counts
+static unsigned int  lf_err_span   = 1;         // Calibrated black - white
+static unsigned int  lf_err_filt   = 0;         // Filtered |error|
+static unsigned int  lf_corr_filt  = 0;         // Filtered |correction|
+#endif
+
+// Lost-line search state (LF_RECOVER only).
+static signed char   lf_last_sign   = 1;        // +1 line last left, -1 right
+static unsigned int  lf_rec_periods = 0;        // Periods since line lost
+static unsigned int  lf_rec_swing_end = 0;      // lf_rec_periods ending swing
+static unsigned char lf_rec_swing   = 0;        // Sweep swings started
+static unsigned long lf_rec_inner_q8 = 0;       // Spiral inner wheel, Q8 counts
+
+// Wheel command, re-submitted to the motor arbiter every period
+// (MOTOR_SRC_LINE, MOTOR_LEASE_LINE) until the run ends.
+static long          lf_cmd_left  = 0;
+static long          lf_cmd_right = 0;
+
+static void lf_drive(long left, long right){
+    lf_cmd_left  = left;
+    lf_cmd_right = right;
+}
 
 void Line_Follow_Start(unsigned int seconds){
     if(!calibration_done){
@@ -305,28 +344,23 @@ void Line_Follow_Start(unsigned int seconds){
         return;
     }
 
-    // Wait for the DAC ramp to finish.  TB0CTL TBIE is cleared by the
-    // overflow ISR (interrupts_timers.c case 14) once DAC_data reaches
-    // DAC_Adjust -- that's when the motor buck-boost rail is at ~6V.
+    // Wait for the DAC soft-start profile to finish (dac.c) -- that's when
+    // the motor buck-boost rail is at ~6V.
     // If we start line-follow before the ramp is done, the SEEK/ALIGN
     // phases run on ~2V which is too weak to overcome wheel friction,
     // and when the ramp completes mid-sequence the motors suddenly
     // jump to full torque -- produces the "spin past the line" symptom.
     // Red LED is ON during ramp, OFF when done, so the user has a
     // visible indicator too.
-    if(TB0CTL & TBIE){
+    if(DAC_Seq_Busy() && DAC_Seq_Profile() == DAC_PROFILE_SOFT_START){
         USB_transmit_string("ERR: motor pwr ramping, wait for RED LED off\r\n");
         return;
     }
 
     Wheels_All_Off();
+    Motor_Release(MOTOR_SRC_CAL);
     mode_cal_active = 0;
 
-    // Switch Port 6 / CCR layout to Project_7's configuration.  Wheels_All_Off
-    // above cleared the P9P2 CCRs; lf_enter_p7_pins zeros them all again and
-    // reconfigures P6.5 as GPIO input.
-    lf_enter_p7_pins();
-
     P2OUT |= IR_LED;
     ir_emitter_on = 1;
 
@@ -339,20 +373,111 @@ void Line_Follow_Start(unsigned int seconds){
     cmd_remaining_ms = seconds * 1000u;     // ms
     mode_line_active = 1;
     line_dbg_cnt     = LINE_DBG_INTERVAL;   // force first LCD update right away
-    lf_last_error    = 0;
+    PID_Init(&lf_pid, lf_kp, lf_ki, lf_kd,
+             LF_PID_OUT_LIMIT, LF_PID_INTEG_LIMIT, LF_PID_D_SHIFT);
+    lf_last_frame      = ADC_frame_count;
+    lf_missed_periods  = 0;
+    lf_recoveries      = 0;
+    lf_recovery_fails  = 0;
+    lf_recovery_ms_max = 0;
+    lf_recovery_ms_sum = 0;
+    lf_last_sign       = 1;
+
+#if LF_GOV_ENABLE
+    // Full-scale error for the governor: the average calibrated swing.
+    lf_err_span = 1;
+    if(black_left > white_left && black_right > white_right){
+        lf_err_span = ((black_left - white_left) + (black_right - white_right)) / 2;
+    }
+#endif
 
     // Begin with the SEEK phase (drive forward hunting for the line).
     lf_sub_state  = LF_SEEK;
+    lf_traced     = 0xFF;
     lf_phase_tick = Time_Sequence;
-    lf_motors_forward(P7_BASE_SPEED, P7_BASE_SPEED);
+    lf_drive(P7_BASE_SPEED, P7_BASE_SPEED);
+    Motor_Request(MOTOR_SRC_LINE, lf_cmd_left, lf_cmd_right, MOTOR_LEASE_LINE);
 
     USB_transmit_string("LINE seek\r\n");
 }
 
+//------------------------------------------------------------------------------
+// End-of-run report so load problems and line losses are visible on the
+// backchannel without a debugger:
+//   "LINE missed ddddd"                    control periods skipped
+//   "LINE recov ddddd fail ddddd max ddddd" searches (max in ms)
+//------------------------------------------------------------------------------
+static void lf_report_run(void){
+    char missed[] = "LINE missed 00000\r\n";
+    char recov[]  = "LINE recov 00000 fail 00000 max 00000\r\n";
+
+    Fmt_Dec(&missed[12], lf_missed_periods, 5, FMT_ZERO);
+    USB_transmit_string(missed);
+    Fmt_Dec(&recov[11], lf_recoveries,      5, FMT_ZERO);
+    Fmt_Dec(&recov[22], lf_recovery_fails,  5, FMT_ZERO);
+    Fmt_Dec(&recov[32], lf_recovery_ms_max, 5, FMT_ZERO);
+    USB_transmit_string(recov);
+}
+
+//------------------------------------------------------------------------------
+// Speed governor -- one call per LF_FOLLOW control period.  A large or fast-
+// growing error and a large wheel differential all mean "curve"; take the
+// worst of the three, map it onto MAX..MIN speed and slew toward it, braking
+// much harder than accelerating.  Without LF_GOV_ENABLE only the (empty)
+// reset is left, so the phase changes call it either way.
+//------------------------------------------------------------------------------
+static void lf_governor_reset(void){
+#if LF_GOV_ENABLE
+    lf_gov_q8    = (unsigned long)P7_BASE_SPEED << 8;
+    lf_err_filt  = 0;
+    lf_corr_filt = 0;
+#endif
+}
+
+#if LF_GOV_ENABLE
+static unsigned int lf_governor(int base_err, int correction){
+    unsigned int  mag;
+    unsigned long demand;
+    unsigned long rate;
+    unsigned long target;
+
+    mag = (unsigned int)(base_err >= 0 ? base_err : -base_err);
+    lf_err_filt  += (int)(mag - lf_err_filt) >> LF_GOV_FILTER_SHIFT;
+    mag = (unsigned int)(correction >= 0 ? correction : -correction);
+    lf_corr_filt += (int)(mag - lf_corr_filt) >> LF_GOV_FILTER_SHIFT;
+
+    demand = ((unsigned long)lf_err_filt << 8) / lf_err_span;
+    rate   = (unsigned long)(lf_pid.d_filt >= 0 ? lf_pid.d_filt : -lf_pid.d_filt);
+    rate   = ((rate * LF_GOV_LOOKAHEAD) << 8) / lf_err_span;
+    if(rate > demand){
+        demand = rate;
+    }
+    mag = (unsigned int)(((unsigned long)lf_corr_filt << 8) / P7_BASE_REF);
+    if(mag > demand){
+        demand = mag;
+    }
+    if(demand > 256){
+        demand = 256;
+    }
+
+    target = ((unsigned long)LF_GOV_MAX_SPEED << 8) -
+             (unsigned long)(LF_GOV_MAX_SPEED - LF_GOV_MIN_SPEED) * demand;
+
+    if(target > lf_gov_q8 + LF_GOV_ACCEL_STEP){
+        lf_gov_q8 += LF_GOV_ACCEL_STEP;
+    } else if(target + LF_GOV_BRAKE_STEP < lf_gov_q8){
+        lf_gov_q8 -= LF_GOV_BRAKE_STEP;
+    } else {
+        lf_gov_q8 = target;
+    }
+    return (unsigned int)(lf_gov_q8 >> 8);
+}
+#endif
+
 //------------------------------------------------------------------------------
 // Periodic LCD update during line-follow.  Every ~0.25 s redraw with:
 //   Line 0: "Er:ddddd   "  |raw ADC error| = |ADC_L - ADC_R|
-//   Line 1: "Cr:ddddd   "  |computed PD correction|
+//   Line 1: "Cr:ddddd   "  |computed PID correction|
 //   Line 2: "Ls:ddddd   "  left  PWM commanded via direct CCR write
 //   Line 3: "Rs:ddddd   "  right PWM commanded via direct CCR write
 //------------------------------------------------------------------------------
@@ -372,122 +497,156 @@ static void line_follow_display(int unused_l, int unused_r){
     lcd_write_value(1, "Cr", (unsigned int)(lf_last_rn < 0 ? 0 : lf_last_rn));
     lcd_write_value(2, "Ls", lf_last_left_spd);
     lcd_write_value(3, "Rs", lf_last_right_spd);
-    display_changed = TRUE;
 }
 
 //------------------------------------------------------------------------------
-// Pin / CCR mode switch.  Line-follow uses Project_7's layout; everything else
-// (F/B/R/L via wheels.c) uses the P9P2 layout.  The switch happens at
-// Line_Follow_Start entry and at Line_Follow_Exit cleanup.
-//
-//   P9P2 layout (wheels.c operates on this):
-//     CCR1 = unused / dead      CCR2 = LEFT_FWD
-//     CCR3 = RIGHT_FWD          CCR4 = LEFT_REV
-//     CCR5 = RIGHT_REV           P6.5 is TB3.5 output
-//
-//   Project_7 layout (this file operates on this during line-follow):
-//     CCR1 = RIGHT_FWD (dead)   CCR2 = LEFT_FWD
-//     CCR3 = RIGHT_REV          CCR4 = LEFT_REV
-//     CCR5 = unused              P6.5 is GPIO input
+// Lost-line search.  lf_recover_begin() is called from LF_FOLLOW on the first
+// period with both sensors off the line; lf_recover_tick() runs once per
+// period after that until either sensor crosses its threshold again.
 //------------------------------------------------------------------------------
-static void lf_enter_p7_pins(void){
-    // Stop everything first (both layouts' pins, defensively).
-    TB3CCR1 = 0;
-    TB3CCR2 = 0;
-    TB3CCR3 = 0;
-    TB3CCR4 = 0;
-    TB3CCR5 = 0;
-    // P6.5 -> GPIO input (Project_7 config).
-    P6SEL0 &= ~P6_5;
-    P6SEL1 &= ~P6_5;
-    P6OUT  &= ~P6_5;
-    P6DIR  &= ~P6_5;
-}
+static void lf_rec_pivot(unsigned char toward_line){
+    signed char dir = toward_line ? lf_last_sign : (signed char)-lf_last_sign;
 
-static void lf_exit_p7_pins(void){
-    // Zero all CCRs so no leftover PWM blips when the P9P2 mapping resumes.
-    TB3CCR1 = 0;
-    TB3CCR2 = 0;
-    TB3CCR3 = 0;
-    TB3CCR4 = 0;
-    TB3CCR5 = 0;
-    // P6.5 -> TB3.5 output (P9P2 config; used for RIGHT_REVERSE).
-    P6SEL0 |=  P6_5;
-    P6SEL1 &= ~P6_5;
-    P6DIR  |=  P6_5;
+    if(dir > 0){
+        lf_drive(-LF_REC_SPIN_SPEED, LF_REC_SPIN_SPEED);   // line was to the left
+    } else {
+        lf_drive(LF_REC_SPIN_SPEED, -LF_REC_SPIN_SPEED);
+    }
 }
 
-//------------------------------------------------------------------------------
-// Direct-CCR motor helpers used DURING line-follow (Project_7 layout).
-// Each one writes CCR1..CCR4 with the H-bridge mutex preserved -- forward
-// and reverse pins of the same wheel are never both non-zero at the same
-// time.
-//------------------------------------------------------------------------------
-static void lf_motors_forward(unsigned int left, unsigned int right){
-    TB3CCR3 = 0;           // right reverse off first
-    TB3CCR4 = 0;           // left  reverse off first
-    TB3CCR1 = right;       // right forward (P6.1 -- dead on this car, harmless)
-    TB3CCR2 = left;        // left  forward
+static void lf_recover_begin(void){
+    lf_rec_periods   = 0;
+    lf_rec_swing     = 0;
+    lf_rec_swing_end = LF_REC_SWING_PERIODS;
+    lf_rec_inner_q8  = 0;
+    lf_rec_pivot(1);
+    lf_sub_state     = LF_RECOVER;
 }
 
-static void lf_motors_reverse(unsigned int speed){
-    TB3CCR1 = 0;           // forward off first
-    TB3CCR2 = 0;
-    TB3CCR3 = speed;       // right reverse
-    TB3CCR4 = speed;       // left  reverse
-}
+static void lf_recover_tick(void){
+    unsigned int ms;
+    char msg[] = "LINE found 00000 ms\r\n";
+
+    // Found it -- log the incident and hand back to the PID with fresh state.
+    // Back on the very next period is a one-sample dropout, not a search:
+    // resume without counting it.
+    if((ADC_Left_Detect  > threshold_left) ||
+       (ADC_Right_Detect > threshold_right)){
+        if(lf_rec_periods == 0){
+            lf_sub_state = LF_FOLLOW;
+            return;
+        }
+        ms = lf_rec_periods * LF_CTRL_MS;
+        lf_recoveries++;
+        lf_recovery_ms_sum += ms;
+        if(ms > lf_recovery_ms_max){
+            lf_recovery_ms_max = ms;
+        }
+        TRACE(TR_LF_FOUND, 0, ms);
+        Fmt_Dec(&msg[11], ms, 5, FMT_ZERO);
+        USB_transmit_string(msg);
+        PID_Reset(&lf_pid);
+        lf_governor_reset();
+        lf_sub_state = LF_FOLLOW;
+        return;
+    }
 
-static void lf_motors_stop(void){
-    TB3CCR1 = 0; TB3CCR2 = 0; TB3CCR3 = 0; TB3CCR4 = 0;
-}
+    // Out of time -- stop here; the cmd_remaining_ms == 0 path at the top of
+    // Line_Follow_Tick reports on the next call.
+    if(++lf_rec_periods == 1){
+        Stats_Inc(STAT_LINE_LOST);          // Search really under way
+    }
+    if(lf_rec_periods >= LF_REC_TIMEOUT){
+        lf_recovery_fails++;
+        lf_drive(0, 0);
+        TRACE(TR_LF_LOST, 0, lf_rec_periods);
+        USB_transmit_string("LINE lost\r\n");
+        cmd_active_dir   = SERIAL_NULL;
+        cmd_remaining_ms = 0;
+        return;
+    }
 
-static void lf_motors_spin_cw(unsigned int speed){
-    // Project_7 Spin_CW = LEFT_FWD + RIGHT_REV = CCR2 + CCR3
-    TB3CCR1 = 0;
-    TB3CCR4 = 0;
-    TB3CCR2 = speed;
-    TB3CCR3 = speed;
-}
+    // Phase 1: widening back-and-forth sweep.
+    if(lf_rec_swing < LF_REC_SWINGS){
+        if(lf_rec_periods >= lf_rec_swing_end){
+            lf_rec_swing++;
+            if(lf_rec_swing < LF_REC_SWINGS){
+                lf_rec_swing_end = lf_rec_periods +
+                                   LF_REC_SWING_PERIODS * (lf_rec_swing + 1);
+                lf_rec_pivot(!(lf_rec_swing & 1));
+            }
+        }
+        if(lf_rec_swing < LF_REC_SWINGS){
+            return;
+        }
+    }
 
-static void lf_motors_spin_ccw(unsigned int speed){
-    // Project_7 Spin_CCW = RIGHT_FWD + LEFT_REV = CCR1 + CCR4
-    TB3CCR2 = 0;
-    TB3CCR3 = 0;
-    TB3CCR1 = speed;
-    TB3CCR4 = speed;
+    // Phase 2: widening spiral toward the last-known side.
+    if(lf_rec_inner_q8 + LF_REC_SPIRAL_GROW < ((unsigned long)LF_REC_SPIRAL_SPEED << 8)){
+        lf_rec_inner_q8 += LF_REC_SPIRAL_GROW;
+    }
+    if(lf_last_sign > 0){
+        lf_drive((long)(lf_rec_inner_q8 >> 8), LF_REC_SPIRAL_SPEED);
+    } else {
+        lf_drive(LF_REC_SPIRAL_SPEED, (long)(lf_rec_inner_q8 >> 8));
+    }
 }
 
 //==============================================================================
-// Line_Follow_Tick -- called from main loop every iteration while active.
+// Line_Follow_Tick -- called from main loop every iteration, but only does
+// work once per completed ADC frame, so every step (and every PID sample) is
+// exactly 1 / LF_CTRL_HZ apart.  If the main loop was slow enough that more
+// than one frame completed since the last step, the extra ones are counted
+// in lf_missed_periods and the controller runs on the newest.
 // Full Project-7 line-following sequence:
 //   1. LF_SEEK   -- drive forward until a sensor crosses threshold
 //   2. LF_PAUSE  -- 1 s stop after detection
 //   3. LF_ALIGN  -- 1 s spin toward line (direction based on which sensor saw it)
-//   4. LF_FOLLOW -- proportional control (byte-identical to P7_FOLLOW_LINE)
+//   4. LF_FOLLOW -- PID steering on the sensor difference
+//   5. LF_RECOVER -- lost-line search, returns to LF_FOLLOW when found
 //
-// Full-time countdown (cmd_remaining_ms) covers the entire sequence.
-// Vehicle_Cmd_Tick handles the final motor stop when the timer expires.
+// Full-time countdown (cmd_remaining_ms) covers the entire sequence.  Each
+// processed frame renews the MOTOR_SRC_LINE lease with the latest lf_drive
+// command; the run ends by releasing it, and a stalled main loop lets it
+// expire.
 //==============================================================================
 void Line_Follow_Tick(void){
     int  correction;
-    int  left_speed;
-    int  right_speed;
+    long left_speed;                // long: P7_MAX_SPEED does not fit an int
+    long right_speed;
+    long scaled;                    // correction scaled to the governed speed
+    unsigned int speed;
     unsigned int phase_elapsed;
+    unsigned int frame;
 
     if(!mode_line_active){
         return;
     }
     if(cmd_remaining_ms == 0){
-        // Overall countdown expired -- Vehicle_Cmd_Tick already stopped motors.
-        // Restore the P9P2 pin layout so F/B/R/L work again.
-        lf_exit_p7_pins();
+        // Overall countdown expired (Vehicle_Cmd_Tick) or the search gave up.
+        TRACE(TR_LF_END, 0, lf_missed_periods);
         mode_line_active = 0;
+        Motor_Release(MOTOR_SRC_LINE);
+        lf_report_run();
         Display_Network_Info();
         return;
     }
 
+    // One step per ADC frame.
+    frame = ADC_frame_count;
+    if(frame == lf_last_frame){
+        return;
+    }
+    lf_missed_periods += (unsigned int)(frame - lf_last_frame) - 1;
+    lf_last_frame      = frame;
+
     phase_elapsed = (unsigned int)(Time_Sequence - lf_phase_tick);
 
+    if(lf_sub_state != lf_traced){
+        lf_traced = lf_sub_state;
+        TRACE(TR_LF_STATE, lf_sub_state, 0);
+    }
+
     switch(lf_sub_state){
 
     //--------------------------------------------------------------------------
@@ -502,12 +661,12 @@ void Line_Follow_Tick(void){
             (ADC_Right_Detect > threshold_right))){
             // Line found -- snapshot which side saw it stronger.
             lf_spin_cw = (ADC_Left_Detect > ADC_Right_Detect) ? 1 : 0;
-            Wheels_All_Off();
+            lf_drive(0, 0);
             USB_transmit_string("LINE detected\r\n");
             lf_sub_state  = LF_PAUSE;
             lf_phase_tick = Time_Sequence;
         }
-        // (Forward_On() was already called in Line_Follow_Start; motors keep running)
+        // (Line_Follow_Start already set both wheels forward; lf_drive keeps them)
         break;
 
     //--------------------------------------------------------------------------
@@ -517,9 +676,9 @@ void Line_Follow_Tick(void){
         if(phase_elapsed >= P7_DETECT_STOP_TIME){
             // Spin toward the side that saw the line (to center both sensors).
             if(lf_spin_cw){
-                lf_motors_spin_cw(P7_SPIN_SPEED);
+                lf_drive(P7_SPIN_SPEED, -P7_SPIN_SPEED);
             } else {
-                lf_motors_spin_ccw(P7_SPIN_SPEED);
+                lf_drive(-P7_SPIN_SPEED, P7_SPIN_SPEED);
             }
             USB_transmit_string("LINE align\r\n");
             lf_sub_state  = LF_ALIGN;
@@ -534,62 +693,76 @@ void Line_Follow_Tick(void){
     case LF_ALIGN:
         if((ADC_Left_Detect  > threshold_left) &&
            (ADC_Right_Detect > threshold_right)){
-            lf_motors_stop();
+            lf_drive(0, 0);
             USB_transmit_string("LINE follow\r\n");
-            lf_last_error = 0;
+            PID_Reset(&lf_pid);
+            lf_governor_reset();
             lf_sub_state  = LF_FOLLOW;
             lf_phase_tick = Time_Sequence;
         } else if(phase_elapsed >= P7_INITIAL_TURN_TIME){
-            lf_motors_stop();
+            lf_drive(0, 0);
             USB_transmit_string("LINE follow\r\n");
-            lf_last_error = 0;
+            PID_Reset(&lf_pid);
+            lf_governor_reset();
             lf_sub_state  = LF_FOLLOW;
             lf_phase_tick = Time_Sequence;
         }
         break;
 
     //--------------------------------------------------------------------------
-    // LF_FOLLOW -- byte-for-byte port of Project_7/Follow_Line using direct
-    // CCR writes on the P7 pin layout.
+    // LF_FOLLOW -- Project_7/Follow_Line structure with the PD law replaced
+    // by the PID block.
     //--------------------------------------------------------------------------
     case LF_FOLLOW:
     {
-        int left_reading  = (int)ADC_Left_Detect;
-        int right_reading = (int)ADC_Right_Detect;
-        unsigned int left_on_line  = (ADC_Left_Detect  > threshold_left);
-        unsigned int right_on_line = (ADC_Right_Detect > threshold_right);
+        int left_reading;
+        int right_reading;
+        unsigned int left_on_line;
+        unsigned int right_on_line;
         int base_err;
-        int delta_err;
 
         // Refresh the LCD display (rate-limited internally).
         line_follow_display(0, 0);
 
-        // Both sensors off line -- reverse to re-find it (Project_7 behaviour).
+        left_reading  = (int)ADC_Left_Detect;
+        right_reading = (int)ADC_Right_Detect;
+        left_on_line  = (ADC_Left_Detect  > threshold_left);
+        right_on_line = (ADC_Right_Detect > threshold_right);
+
+        // Both sensors off line -- start the search toward lf_last_sign.
         if(!left_on_line && !right_on_line){
-            lf_motors_reverse(P7_REVERSE_SPEED);
+            lf_recover_begin();
             lf_last_left_spd  = 0;
             lf_last_right_spd = 0;
-            // Do NOT update lf_last_error -- preserve for re-acquisition.
             break;
         }
 
-        // At least one sensor sees the line -- PD forward control.
-        base_err      = left_reading - right_reading;
-        delta_err     = base_err - lf_last_error;
-        lf_last_error = base_err;
+        // At least one sensor sees the line -- PID forward control.
+        base_err   = left_reading - right_reading;
+        correction = PID_Update(&lf_pid, base_err);
+        if(base_err > 0){
+            lf_last_sign = 1;               // left darker: line to the left
+        } else if(base_err < 0){
+            lf_last_sign = -1;
+        }
 
-        correction = (P7_KP * base_err) + (P7_KD * delta_err);
-        correction = correction / P7_PD_DIVISOR;
+#if LF_GOV_ENABLE
+        speed      = lf_governor(base_err, correction);
+        scaled     = ((long)correction * speed) / P7_BASE_REF;
+#else
+        speed      = P7_BASE_SPEED;
+        scaled     = ((long)correction * P7_BASE_SPEED) / P7_BASE_REF;
+#endif
 
-        left_speed  = (int)P7_BASE_SPEED - correction;
-        right_speed = (int)P7_BASE_SPEED + correction;
+        left_speed  = (long)speed - scaled;
+        right_speed = (long)speed + scaled;
 
-        if(left_speed  < 0)                    left_speed  = 0;
-        if(right_speed < 0)                    right_speed = 0;
-        if(left_speed  > (int)P7_MAX_SPEED)    left_speed  = (int)P7_MAX_SPEED;
-        if(right_speed > (int)P7_MAX_SPEED)    right_speed = (int)P7_MAX_SPEED;
+        if(left_speed  < 0)                     left_speed  = 0;
+        if(right_speed < 0)                     right_speed = 0;
+        if(left_speed  > (long)P7_MAX_SPEED)    left_speed  = (long)P7_MAX_SPEED;
+        if(right_speed > (long)P7_MAX_SPEED)    right_speed = (long)P7_MAX_SPEED;
 
-        lf_motors_forward((unsigned int)left_speed, (unsigned int)right_speed);
+        lf_drive(left_speed, right_speed);
 
         // Snapshot for LCD display
         lf_last_ln        = base_err >= 0 ? base_err : -base_err;   // |err|
@@ -598,13 +771,48 @@ void Line_Follow_Tick(void){
         lf_last_right_spd = (unsigned int)right_speed;
     } break;
 
+    //--------------------------------------------------------------------------
+    // LF_RECOVER -- lost-line search (see LF_REC_* in macros.h).
+    //--------------------------------------------------------------------------
+    case LF_RECOVER:
+        lf_recover_tick();
+        break;
+
     default:
         // Shouldn't happen; bail safely.
         mode_line_active = 0;
-        Wheels_All_Off();
-        break;
+        Motor_Release(MOTOR_SRC_LINE);
+        return;
     }
 
-    // Rate diagnostic (toggles every tick while line-follow is active).
+    Motor_Request(MOTOR_SRC_LINE, lf_cmd_left, lf_cmd_right, MOTOR_LEASE_LINE);
+
+    // Rate diagnostic (toggles every control period while line-follow is
+    // active -- a clean LF_CTRL_HZ / 2 square wave means no missed periods).
     P2OUT ^= IOT_RUN_RED;
 }
+
+//==============================================================================
+// Line_Follow_Set_Gain -- ^1234P/I/D<q8> arrived.  value is the raw Q8.8 gain
+// (256 = 1.0).  Takes effect on the very next control sample if line-follow
+// is running, otherwise on the next ^N.
+//==============================================================================
+void Line_Follow_Set_Gain(char which, unsigned int value){
+    switch(which){
+        case CMD_DIR_SET_KP:
+            lf_kp = (int)value;
+            USB_transmit_string("PID kp set\r\n");
+            break;
+        case CMD_DIR_SET_KI:
+            lf_ki = (int)value;
+            USB_transmit_string("PID ki set\r\n");
+            break;
+        case CMD_DIR_SET_KD:
+            lf_kd = (int)value;
+            USB_transmit_string("PID kd set\r\n");
+            break;
+        default:
+            return;
+    }
+    PID_Set_Gains(&lf_pid, lf_kp, lf_ki, lf_kd);
+}
@@ -24,12 +24,23 @@ extern unsigned int calibration_done;   // 1 once white+black both captured
 extern volatile unsigned char mode_cal_active;
 extern volatile unsigned char mode_line_active;
 
+// ADC frames (control periods) line-follow skipped because the main loop
+// came round too late.  Reset at each ^N, reported when the run ends.
+extern unsigned int lf_missed_periods;
+
+// Lost-line recovery statistics for the current / last ^N run.
+extern unsigned int  lf_recoveries;       // Searches that re-found the line
+extern unsigned int  lf_recovery_fails;   // Searches that timed out
+extern unsigned int  lf_recovery_ms_max;  // Longest successful search, ms
+extern unsigned long lf_recovery_ms_sum;  // Total search time, ms
+
 //------------------------------------------------------------------------------
 // Called from +IPD parser when a Q / C / N command arrives
 //------------------------------------------------------------------------------
 void Quit_Everything(void);      // Q: abort cmd/queue/cal/line
 void Calibration_Start(void);    // C: kick off calibration state machine
 void Line_Follow_Start(unsigned int seconds);  // N: begin line follow
+void Line_Follow_Set_Gain(char which, unsigned int value); // P/I/D: Q8.8 gain
 
 //------------------------------------------------------------------------------
 // Called from main loop every iteration
@@ -0,0 +1,248 @@
+//==============================================================================
+// File:        motor.c
+// Description: Motor HAL: request arbiter, slew limiter and H-bridge
+//              dead-time (see motor.h).
+//
+//              Motor_Ramp_Tick runs once per Timer B1 period.  It first
+//              picks exactly one winning request (motor_arbitrate), then
+//              steps each wheel's applied speed toward it.  Speeding up is
+//              limited to MOTOR_ACCEL_STEP per period, slowing down (and the
+//              first half of a reversal) to MOTOR_DECEL_STEP, so a timed
+//              F/B/R/L covers the same ground every time and the motor rail
+//              never sees a full-speed step.  Line-follow and ESTOP requests
+//              bypass the limiter and reach the bridge from Motor_Request
+//              itself: a PID correction held back by the ramp (or by the
+//              wait for the next tick) arrives too late on a curve.
+//
+//              motor_wheel is the only writer of the motor CCRs.  Dead time
+//              is left to Timer B3 itself: the CCRs latch at the period
+//              start (CLLD_1), where every driven leg rises, and no duty
+//              exceeds MOTOR_SPEED_MAX, so the leg a reversal turns off has
+//              fallen on its own compare at least MOTOR_DEAD_COUNTS before
+//              the other one rises.  No ISR, no per-wheel dead-time state.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "msp430.h"
+#include "macros.h"
+#include "ports.h"
+#include "motor.h"
+
+#if (SMCLK_HZ / MOTOR_PWM_HZ) * (MOTOR_ACCEL_RATE / LF_CTRL_HZ) < 10000UL || \
+    (SMCLK_HZ / MOTOR_PWM_HZ) * (MOTOR_DECEL_RATE / LF_CTRL_HZ) < 10000UL
+#error "MOTOR_ACCEL_STEP / MOTOR_DECEL_STEP round to 0 counts at this MOTOR_PWM_HZ"
+#endif
+#if SMCLK_HZ / 1000000UL * MOTOR_DEAD_TIME_US >= SMCLK_HZ / MOTOR_PWM_HZ / 2
+#error "MOTOR_DEAD_TIME_US takes half the PWM period or more"
+#endif
+
+// Sources whose targets bypass the slew limiter
+#define MOTOR_SRC_DIRECT(src)   ((src) == MOTOR_SRC_LINE || (src) == MOTOR_SRC_ESTOP)
+
+typedef struct {
+    long         left;
+    long         right;
+    unsigned int lease;             // Control periods left, 0 = no request
+} motor_req_t;
+
+// Written by producers with the ramp ISR masked, read/aged by the ISR.
+static motor_req_t motor_req[MOTOR_SRC_COUNT];
+
+// Speed the ramp has reached.  Timer1_B0 owns them; Motor_Request and
+// Motor_Halt write them only with that interrupt masked.
+static long motor_left_now  = 0;
+static long motor_right_now = 0;
+
+//------------------------------------------------------------------------------
+// motor_slew -- one period's step from now toward target.  Moving away from
+// zero uses the accel step, moving toward zero the decel step; a step that
+// would cross zero stops at zero so the reversal restarts from standstill.
+//------------------------------------------------------------------------------
+static long motor_slew(long now, long target){
+    if(target > now){
+        if(now < 0){
+            now += MOTOR_DECEL_STEP;
+            if(now > 0){
+                now = 0;
+            }
+        } else {
+            now += MOTOR_ACCEL_STEP;
+        }
+        if(now > target){
+            now = target;
+        }
+    } else if(target < now){
+        if(now > 0){
+            now -= MOTOR_DECEL_STEP;
+            if(now < 0){
+                now = 0;
+            }
+        } else {
+            now -= MOTOR_ACCEL_STEP;
+        }
+        if(now < target){
+            now = target;
+        }
+    }
+    return now;
+}
+
+//------------------------------------------------------------------------------
+// motor_wheel -- one wheel, given its two CCRs.  The CCR pointers are
+// compile-time constants at every call site, so after inlining this is two
+// stores and the sign test.  The idle leg is cleared first: if the period
+// boundary falls between the stores, the 0 latches alone and the new duty
+// one period later.
+//------------------------------------------------------------------------------
+static inline void motor_wheel(volatile unsigned int *fwd,
+                               volatile unsigned int *rev, long speed){
+    if(speed > MOTOR_SPEED_MAX){
+        speed = MOTOR_SPEED_MAX;
+    } else if(speed < -MOTOR_SPEED_MAX){
+        speed = -MOTOR_SPEED_MAX;
+    }
+    if(speed >= 0){
+        *rev = WHEEL_OFF;
+        *fwd = (unsigned int)speed;
+    } else {
+        *fwd = WHEEL_OFF;
+        *rev = (unsigned int)(-speed);
+    }
+}
+
+static inline void motor_left(long speed){
+    motor_wheel(&LEFT_FORWARD_SPEED, &LEFT_REVERSE_SPEED, speed);
+}
+
+static inline void motor_right(long speed){
+    motor_wheel(&RIGHT_FORWARD_SPEED, &RIGHT_REVERSE_SPEED, speed);
+}
+
+//------------------------------------------------------------------------------
+// motor_arbitrate -- one control period: the lowest-numbered (highest
+// priority) live slot wins, and every live lease ages by one period.
+// Returns the winner, MOTOR_SRC_COUNT if no slot is live.
+//------------------------------------------------------------------------------
+static unsigned char motor_arbitrate(long *left, long *right){
+    motor_req_t   *r;
+    unsigned char i;
+    unsigned char won = MOTOR_SRC_COUNT;
+
+    *left  = 0;
+    *right = 0;
+    for(i = 0; i < MOTOR_SRC_COUNT; i++){
+        r = &motor_req[i];
+        if(r->lease == 0){
+            continue;
+        }
+        if(won == MOTOR_SRC_COUNT){
+            *left  = r->left;
+            *right = r->right;
+            won    = i;
+        }
+        if(r->lease != MOTOR_LEASE_HOLD){
+            r->lease--;
+        }
+    }
+    return won;
+}
+
+//------------------------------------------------------------------------------
+// motor_top -- highest-priority live slot, MOTOR_SRC_COUNT if none.
+//------------------------------------------------------------------------------
+static unsigned char motor_top(void){
+    unsigned char i;
+
+    for(i = 0; i < MOTOR_SRC_COUNT; i++){
+        if(motor_req[i].lease != 0){
+            break;
+        }
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------
+// motor_set -- move both wheels' applied speed to left / right.
+//------------------------------------------------------------------------------
+static void motor_set(long left, long right){
+    if(left != motor_left_now){
+        motor_left_now = left;
+        motor_left(left);
+    }
+    if(right != motor_right_now){
+        motor_right_now = right;
+        motor_right(right);
+    }
+}
+
+//==============================================================================
+// Motor_Request -- submit (or renew) src's speed pair for lease periods.
+// A LINE / ESTOP request that is the top live slot goes to the bridge now;
+// anything else takes effect at the next control period.
+//==============================================================================
+void Motor_Request(unsigned char src, long left, long right, unsigned int lease){
+    if(src >= MOTOR_SRC_COUNT){
+        return;
+    }
+    TB1CCTL0 &= ~CCIE;              // long stores are two word writes
+    motor_req[src].left  = left;
+    motor_req[src].right = right;
+    motor_req[src].lease = lease;
+    if(lease != 0 && MOTOR_SRC_DIRECT(src) && motor_top() == src){
+        motor_set(left, right);
+    }
+    TB1CCTL0 |=  CCIE;
+}
+
+//==============================================================================
+// Motor_Release -- drop src's request; the next source down takes over.
+//==============================================================================
+void Motor_Release(unsigned char src){
+    if(src >= MOTOR_SRC_COUNT){
+        return;
+    }
+    motor_req[src].lease = 0;       // single word store, no masking needed
+}
+
+//==============================================================================
+// Motor_Ramp_Tick -- Timer1_B0_ISR, every 1 / LF_CTRL_HZ.
+//==============================================================================
+void Motor_Ramp_Tick(void){
+    long          left;
+    long          right;
+    unsigned char src;
+
+    src = motor_arbitrate(&left, &right);
+    if(!MOTOR_SRC_DIRECT(src)){
+        left  = motor_slew(motor_left_now,  left);
+        right = motor_slew(motor_right_now, right);
+    }
+    motor_set(left, right);
+}
+
+//==============================================================================
+// Motor_Halt -- emergency stop (^Q): every request dropped, ramp state and
+// CCRs to 0 in one step, and the ESTOP slot holds zero for
+// MOTOR_LEASE_ESTOP so a producer that was mid-update cannot restart the
+// wheels.  The CCRs latch at the next period start like any other write.
+//==============================================================================
+void Motor_Halt(void){
+    unsigned char i;
+
+    TB1CCTL0 &= ~CCIE;
+    for(i = 0; i < MOTOR_SRC_COUNT; i++){
+        motor_req[i].lease = 0;
+    }
+    motor_req[MOTOR_SRC_ESTOP].left  = 0;
+    motor_req[MOTOR_SRC_ESTOP].right = 0;
+    motor_req[MOTOR_SRC_ESTOP].lease = MOTOR_LEASE_ESTOP;
+    motor_left_now  = 0;
+    motor_right_now = 0;
+    motor_left(0);
+    motor_right(0);
+    TB1CCTL0 |=  CCIE;
+}
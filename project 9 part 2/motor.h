@@ -0,0 +1,70 @@
+//==============================================================================
+// File:        motor.h
+// Description: Motor HAL for Project 9 Part 2 -- the only code that writes
+//              the Timer B3 motor CCRs.
+//
+//              Each wheel takes a signed speed in PWM counts: > 0 forward,
+//              < 0 reverse, 0 coast.  Magnitude is clamped to
+//              MOTOR_SPEED_MAX.  One signed number per wheel is the whole
+//              interface, so there is no way to ask for forward and reverse
+//              on the same wheel at once.
+//
+//              Nothing writes a target directly.  Each producer (TCP
+//              F/B/R/L, calibration, line-follow, ^Q) owns one request slot
+//              and submits a speed pair with a lease in control periods.
+//              Once per control period Motor_Ramp_Tick (motor.c, from
+//              Timer1_B0_ISR) takes the highest-priority slot whose lease
+//              is still running as the target -- no slot means stop.  For
+//              TELEOP, CAL and no slot it moves each wheel toward the target
+//              by at most MOTOR_ACCEL_STEP (speeding up) or MOTOR_DECEL_STEP
+//              (slowing down), passing through zero on a direction change.
+//              LINE and ESTOP targets are applied as they stand -- the PID
+//              needs its correction this period, not MOTOR_DECEL_STEP later.
+//              Motor_Halt skips the ramp for ^Q and takes the ESTOP slot.
+//
+//              Output stage (motor.c): CCR loads are latched at the start of
+//              a PWM period (CLLD_1), so both legs of a wheel change on the
+//              same edge, and duty stops MOTOR_DEAD_COUNTS short of the
+//              period.  On a reversal the old leg's last pulse therefore
+//              ends on its TB3 compare at least MOTOR_DEAD_TIME_US before
+//              the new leg rises -- timed by the timer, not by software
+//              delays, and not by callers remembering Wheels_All_Off.
+//
+//              Channel map (wheel -> forward CCR / reverse CCR) is the
+//              *_FORWARD_SPEED / *_REVERSE_SPEED macros in ports.h, which
+//              record this car's empirical wiring.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef MOTOR_H_
+#define MOTOR_H_
+
+#include "macros.h"
+#include "ports.h"
+
+#define MOTOR_SPEED_MAX     ((long)WHEEL_PERIOD_VAL - MOTOR_DEAD_COUNTS)
+
+//------------------------------------------------------------------------------
+// Request sources, highest priority first.  A source only ever touches its
+// own slot, so the Timer B0 auto-stop releasing MOTOR_SRC_TELEOP cannot
+// cancel a line-follow command, and vice versa.
+//------------------------------------------------------------------------------
+#define MOTOR_SRC_ESTOP     (0)         // ^Q (Motor_Halt only)
+#define MOTOR_SRC_CAL       (1)         // Calibration holds the car still
+#define MOTOR_SRC_LINE      (2)         // Line_Follow_Tick
+#define MOTOR_SRC_TELEOP    (3)         // F/B/R/L (wheels.c)
+#define MOTOR_SRC_COUNT     (4)
+
+#define MOTOR_LEASE_HOLD    (0xFFFFu)   // Never expires; Motor_Release ends it
+
+// Speeds are signed PWM counts; lease is in control periods (0 = release).
+void Motor_Request(unsigned char src, long left, long right, unsigned int lease);
+void Motor_Release(unsigned char src);
+void Motor_Halt(void);                  // All CCRs to 0 now, no ramp
+void Motor_Ramp_Tick(void);             // Timer1_B0_ISR, every control period
+
+#endif /* MOTOR_H_ */
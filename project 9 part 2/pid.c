@@ -0,0 +1,97 @@
+//==============================================================================
+// File:        pid.c
+// Description: Fixed-point PID controller block (Project 9 Part 2).
+//              See pid.h for the control law and Q-format conventions.
+//
+//              All products are formed in 32-bit (long) so a full-scale
+//              12-bit ADC error times a Q8.8 gain cannot overflow; the
+//              compiler maps these onto the MPY32 hardware multiplier.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "pid.h"
+
+//==============================================================================
+// PID_Init -- set gains and limits, then clear all dynamic state.
+//   out_limit   : output clamp, in output units (e.g. PWM counts)
+//   integ_limit : integral-term clamp, in output units
+//   d_shift     : derivative low-pass strength (d += (raw - d) >> d_shift)
+//==============================================================================
+void PID_Init(pid_ctrl_t *pid, int kp, int ki, int kd,
+              int out_limit, int integ_limit, unsigned char d_shift){
+    pid->kp          = kp;
+    pid->ki          = ki;
+    pid->kd          = kd;
+    pid->out_limit   = out_limit;
+    pid->integ_limit = (long)integ_limit << PID_Q_SHIFT;
+    pid->d_shift     = d_shift;
+    PID_Reset(pid);
+}
+
+//==============================================================================
+// PID_Set_Gains -- live gain update.  The integral accumulator already holds
+// ki*e products, so changing ki does not step the output.
+//==============================================================================
+void PID_Set_Gains(pid_ctrl_t *pid, int kp, int ki, int kd){
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+}
+
+//==============================================================================
+// PID_Reset -- clear integrator, derivative filter and history.  The next
+// PID_Update() seeds last_err so the first sample produces no derivative kick.
+//==============================================================================
+void PID_Reset(pid_ctrl_t *pid){
+    pid->integ    = 0;
+    pid->d_filt   = 0;
+    pid->last_err = 0;
+    pid->last_out = 0;
+    pid->primed   = 0;
+}
+
+//==============================================================================
+// PID_Update -- run one sample of the control law.  Call exactly once per
+// control period.  Returns the clamped output (also kept in last_out).
+//==============================================================================
+int PID_Update(pid_ctrl_t *pid, int error){
+    long acc;
+    long limit_q;
+    int  d_raw;
+
+    if(!pid->primed){
+        pid->last_err = error;
+        pid->primed   = 1;
+    }
+
+    // Derivative on the sample-to-sample error change, low-pass filtered.
+    d_raw         = error - pid->last_err;
+    pid->last_err = error;
+    pid->d_filt  += (d_raw - pid->d_filt) >> pid->d_shift;
+
+    // P + D in Q8 output units.
+    acc  = (long)pid->kp * error;
+    acc += (long)pid->kd * pid->d_filt;
+
+    // Anti-windup: only integrate when the previous output was not pinned
+    // against the limit in the direction this error would push it.
+    if(!((pid->last_out >=  pid->out_limit && error > 0) ||
+         (pid->last_out <= -pid->out_limit && error < 0))){
+        pid->integ += (long)pid->ki * error;
+        if(pid->integ >  pid->integ_limit) pid->integ =  pid->integ_limit;
+        if(pid->integ < -pid->integ_limit) pid->integ = -pid->integ_limit;
+    }
+    acc += pid->integ;
+
+    // Clamp, then round to nearest instead of truncating toward zero.
+    limit_q = (long)pid->out_limit << PID_Q_SHIFT;
+    if(acc >  limit_q) acc =  limit_q;
+    if(acc < -limit_q) acc = -limit_q;
+    pid->last_out = (int)((acc + PID_Q_HALF) >> PID_Q_SHIFT);
+
+    return pid->last_out;
+}
@@ -0,0 +1,52 @@
+//==============================================================================
+// File:        pid.h
+// Description: Fixed-point PID controller block (Project 9 Part 2).
+//
+//              Gains are Q8.8 (PID_Q_ONE = 256 = 1.0) and are "per sample":
+//              PID_Update() must be called exactly once per control period,
+//              so the caller owns the sample clock and dt never appears in
+//              the math.
+//
+//              output = (kp*e + I + kd*d_filt) / 256   (rounded, clamped)
+//                I      += ki*e   (clamped to +/-integ_limit, frozen while
+//                                  the output is saturated in the same
+//                                  direction -- anti-windup)
+//                d_filt += (de - d_filt) >> d_shift   (1st-order low-pass)
+//
+//              Gains can be changed live (PID_Set_Gains) without bumping the
+//              output because ki is applied before accumulation.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef PID_H_
+#define PID_H_
+
+#define PID_Q_SHIFT     (8)
+#define PID_Q_ONE       (1 << PID_Q_SHIFT)     // 1.0 in Q8.8
+#define PID_Q_HALF      (1L << (PID_Q_SHIFT - 1))
+
+typedef struct {
+    int           kp;           // Q8.8 proportional gain
+    int           ki;           // Q8.8 integral gain (per sample)
+    int           kd;           // Q8.8 derivative gain (per sample)
+    long          integ;        // Integral accumulator, Q8 output units
+    long          integ_limit;  // |integ| clamp, Q8 output units
+    int           out_limit;    // |output| clamp, output units
+    int           d_filt;       // Low-pass filtered error delta
+    unsigned char d_shift;      // Derivative filter strength (0 = none)
+    unsigned char primed;       // 0 until the first sample has been seen
+    int           last_err;     // Error from the previous sample
+    int           last_out;     // Most recent (clamped) output
+} pid_ctrl_t;
+
+void PID_Init(pid_ctrl_t *pid, int kp, int ki, int kd,
+              int out_limit, int integ_limit, unsigned char d_shift);
+void PID_Set_Gains(pid_ctrl_t *pid, int kp, int ki, int kd);
+void PID_Reset(pid_ctrl_t *pid);
+int  PID_Update(pid_ctrl_t *pid, int error);
+
+#endif /* PID_H_ */
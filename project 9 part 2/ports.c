@@ -291,8 +291,10 @@ void Init_Port5(void){
     P5OUT  &= ~V_5;
     P5DIR  &= ~V_5;
 
-    P5SEL0 &= ~V_DAC;
-    P5SEL1 &= ~V_DAC;
+    // P5.2 -- V_DAC: motor rail through the board divider (ADC A10), read
+    // by the rail regulator in dac.c
+    P5SEL0 |=  V_DAC;
+    P5SEL1 |=  V_DAC;
     P5OUT  &= ~V_DAC;
     P5DIR  &= ~V_DAC;
 
@@ -26,9 +26,14 @@
 #include <string.h>
 #include "macros.h"
 #include "serial.h"
+#include "baud.h"
+#include "loopstat.h"
+#include "stackmon.h"
+#include "trace.h"
+#include "stats.h"
 
 //==============================================================================
-// External globals (LCD display -- defined in LCD.obj)
+// External globals (LCD display -- defined in LCD.c)
 //==============================================================================
 extern char                  display_line[4][11]; // LCD line buffers
 extern volatile unsigned char display_changed;    // Set to signal LCD refresh
@@ -37,9 +42,22 @@ extern volatile unsigned char display_changed;    // Set to signal LCD refresh
 // Module global definitions (declared extern in serial.h)
 //==============================================================================
 
-// IOT ring buffer -- filled by eUSCI_A0_ISR
-volatile char         IOT_Ring_Rx[IOT_RING_SIZE];
-volatile unsigned int iot_rx_wr = BEGINNING;
+#if !BAUD_OK(BAUD_BRCLK_HZ, UART_BAUD_9600) || !BAUD_OK(BAUD_BRCLK_HZ, UART_BAUD_115200)
+#error "UART bit-rate error over BAUD_ERR_MAX_PPM at this clock (baud.h)"
+#endif
+
+#if (IOT_RING_SIZE & IOT_RING_MASK) || (USB_RING_SIZE & USB_RING_MASK)
+#error "IOT_RING_SIZE and USB_RING_SIZE must be powers of two"
+#endif
+
+// IOT ring buffer -- filled by eUSCI_A0_ISR.  When it is full the ISR drops
+// the byte, counts the overflow and leaves a SERIAL_NULL gap marker in front
+// of the next byte that fits; IOT_Process throws away the line with the gap
+// instead of parsing a spliced +IPD frame.
+volatile char          IOT_Ring_Rx[IOT_RING_SIZE];
+volatile unsigned int  iot_rx_wr       = BEGINNING;
+volatile unsigned char iot_rx_overflow = FALSE;    // Cleared once IOT_Process reports it
+static volatile unsigned char iot_rx_gap = FALSE;  // Marker still to be written
 
 // USB ring buffer -- filled by eUSCI_A1_ISR
 volatile char         USB_Ring_Rx[USB_RING_SIZE];
@@ -48,8 +66,8 @@ volatile unsigned int usb_rx_wr = BEGINNING;
 // PC TX gate: blocks all FRAM->PC output until PC sends first character
 volatile unsigned char pc_ok_to_tx = FALSE;
 
-// Main-loop read index for IOT ring buffer (non-volatile)
-         unsigned int iot_rx_rd = BEGINNING;
+// Main-loop read index for IOT ring buffer (the ISR reads it for "full")
+volatile unsigned int iot_rx_rd = BEGINNING;
 
 // TX buffer: loaded by Serial_Transmit(), drained by TX ISR.
 // Sized for full AT commands (e.g. "AT+CIPSERVER=1,65535\r\n" + null).
@@ -67,14 +85,13 @@ unsigned char baud_rate_index = BAUD_115200;       // IOT default 115,200
 char         IOT_Data[IOT_DATA_LINES][IOT_DATA_COLS];
 unsigned int iot_data_line  = BEGINNING;
 static unsigned int iot_data_col = BEGINNING;
+static unsigned char iot_data_skip = FALSE;        // Drop bytes until LF (gap)
 
 //------------------------------------------------------------------------------
 // Init_Serial_UCA0 -- IOT serial port (J9), P1.6=RXD, P1.7=TXD
 // speed: BAUD_115200 (0) or BAUD_9600 (1)
-//
-// Baud rate register values (SMCLK = 8 MHz):
-//   115200: BRW=4,  MCTLW=0x5551
-//   9600:   BRW=52, MCTLW=0x4911
+// BRW / MCTLW from baud.h for the current SMCLK (8 MHz: 4 / 0x5551 and
+// 52 / 0x2511).
 //------------------------------------------------------------------------------
 void Init_Serial_UCA0(char speed){
   UCA0CTLW0  =  UCSWRST;           // Hold in reset during config
@@ -87,11 +104,11 @@ void Init_Serial_UCA0(char speed){
   UCA0CTLW0 |=  UCMODE_0;          // UART mode
 
   if(speed == BAUD_9600){
-    UCA0BRW   = 52;
-    UCA0MCTLW = 0x4911;
+    UCA0BRW   = BAUD_BRW(BAUD_BRCLK_HZ, UART_BAUD_9600);
+    UCA0MCTLW = BAUD_MCTLW(BAUD_BRCLK_HZ, UART_BAUD_9600);
   } else {                          // Default: 115200
-    UCA0BRW   = 4;
-    UCA0MCTLW = 0x5551;
+    UCA0BRW   = BAUD_BRW(BAUD_BRCLK_HZ, UART_BAUD_115200);
+    UCA0MCTLW = BAUD_MCTLW(BAUD_BRCLK_HZ, UART_BAUD_115200);
   }
 
   UCA0CTLW0 &= ~UCSWRST;           // Release from reset
@@ -116,11 +133,11 @@ void Init_Serial_UCA1(char speed){
   UCA1CTLW0 |=  UCMODE_0;          // UART mode
 
   if(speed == BAUD_9600){
-    UCA1BRW   = 52;
-    UCA1MCTLW = 0x4911;
+    UCA1BRW   = BAUD_BRW(BAUD_BRCLK_HZ, UART_BAUD_9600);
+    UCA1MCTLW = BAUD_MCTLW(BAUD_BRCLK_HZ, UART_BAUD_9600);
   } else {                          // Default: 115200
-    UCA1BRW   = 4;
-    UCA1MCTLW = 0x5551;
+    UCA1BRW   = BAUD_BRW(BAUD_BRCLK_HZ, UART_BAUD_115200);
+    UCA1MCTLW = BAUD_MCTLW(BAUD_BRCLK_HZ, UART_BAUD_115200);
   }
 
   UCA1CTLW0 &= ~UCSWRST;           // Release from reset
@@ -134,6 +151,9 @@ void Init_Serial_UCA1(char speed){
 //              Each LF (0x0A) finishes a row; the row is null-terminated and
 //              iot_data_line advances.  CR (0x0D) is ignored (not stored).
 //              IOT_Data rows are scanned by the IOT state machine.
+//              A SERIAL_NULL gap marker (ring overflow) discards the row
+//              being assembled and the rest of that line, and reports the
+//              overflow once on the PC backchannel (clears iot_rx_overflow).
 //==============================================================================
 void IOT_Process(void){
     unsigned int iot_rx_wr_snap;
@@ -142,9 +162,28 @@ void IOT_Process(void){
     iot_rx_wr_snap = iot_rx_wr;
 
     while(iot_rx_wr_snap != iot_rx_rd){
-        incoming_byte = IOT_Ring_Rx[iot_rx_rd++];
-        if(iot_rx_rd >= IOT_RING_SIZE){
-            iot_rx_rd = BEGINNING;
+        incoming_byte = IOT_Ring_Rx[iot_rx_rd];
+        iot_rx_rd     = (iot_rx_rd + 1) & IOT_RING_MASK;
+
+        if(incoming_byte == SERIAL_NULL){
+            // Gap marker -- bytes were lost here
+            IOT_Data[iot_data_line][0] = SERIAL_NULL;
+            iot_data_col  = BEGINNING;
+            iot_data_skip = TRUE;
+            if(iot_rx_overflow){
+                iot_rx_overflow = FALSE;
+                USB_transmit_string("\r\nERR: IOT RX overflow, line dropped\r\n");
+            }
+            iot_rx_wr_snap = iot_rx_wr;
+            continue;
+        }
+
+        if(iot_data_skip){
+            if(incoming_byte == SERIAL_LF){
+                iot_data_skip = FALSE;
+            }
+            iot_rx_wr_snap = iot_rx_wr;
+            continue;
         }
 
         if(incoming_byte == SERIAL_CR){
@@ -235,13 +274,16 @@ void Update_Baud_Display(void){
 void Clear_Serial_Buffers(void){
     UCA0IE &= ~UCTXIE;
 
-    iot_rx_wr = BEGINNING;
-    iot_rx_rd = BEGINNING;
+    iot_rx_wr       = BEGINNING;
+    iot_rx_rd       = BEGINNING;
+    iot_rx_gap      = FALSE;
+    iot_rx_overflow = FALSE;
 
     iot_tx = BEGINNING;
 
     iot_data_line = BEGINNING;
     iot_data_col  = BEGINNING;
+    iot_data_skip = FALSE;
     IOT_Data[0][0] = SERIAL_NULL;
 
     command_ready = 0;
@@ -254,19 +296,39 @@ void Clear_Serial_Buffers(void){
 //------------------------------------------------------------------------------
 #pragma vector = EUSCI_A0_VECTOR
 __interrupt void eUSCI_A0_ISR(void){
-  char iot_receive;
+  char         iot_receive;
+  unsigned int next;
 
   switch(__even_in_range(UCA0IV, 0x08)){
     case 0: break;                        // No interrupt
 
     case 2:{                              // RX -- character from ESP32
+      if(UCA0STATW & UCOE){               // Read before RXBUF clears it
+        Stats_Inc(STAT_UCA0_OVERRUN);
+      }
       iot_receive = UCA0RXBUF;
       P6OUT ^= GRN_LED;                  // DEBUG: toggle GRN every ESP32 byte
 
-      // Store in IOT ring buffer
-      IOT_Ring_Rx[iot_rx_wr++] = iot_receive;
-      if(iot_rx_wr >= IOT_RING_SIZE){
-        iot_rx_wr = BEGINNING;
+      // Store in IOT ring buffer.  After a drop the gap marker goes in
+      // first, and only once it and this byte both fit -- until then the
+      // run of lost bytes continues, so it is counted once.
+      next = (iot_rx_wr + 1) & IOT_RING_MASK;
+      if(iot_rx_gap && next != iot_rx_rd &&
+         ((next + 1) & IOT_RING_MASK) != iot_rx_rd){
+        IOT_Ring_Rx[iot_rx_wr] = SERIAL_NULL;
+        iot_rx_wr  = next;
+        next       = (next + 1) & IOT_RING_MASK;
+        iot_rx_gap = FALSE;
+      }
+      if(!iot_rx_gap){                    // else: dropped, same run
+        if(next == iot_rx_rd){
+          iot_rx_gap      = TRUE;         // One count per run of lost bytes
+          iot_rx_overflow = TRUE;
+          Stats_Inc(STAT_IOT_RX_OVERFLOW);
+        } else {
+          IOT_Ring_Rx[iot_rx_wr] = iot_receive;
+          iot_rx_wr = next;
+        }
       }
 
       // Forward to PC only if PC gate is open
@@ -293,7 +355,8 @@ __interrupt void eUSCI_A0_ISR(void){
 // eUSCI_A1_ISR -- PC backchannel
 // RX: character arrived from PC.
 //     - First byte unlocks pc_ok_to_tx (PC->FRAM gate).
-//     - If byte is '^', start collecting a FRAM-only command (^^, ^F, ^S);
+//     - If byte is '^', start collecting a FRAM-only command
+//       (^^, ^F, ^S, ^L, ^M, ^T, ^?, ^!);
 //       these are consumed by the FRAM and NEVER forwarded to the ESP32.
 //     - Otherwise, passthrough to IOT (UCA0) and echo to PC.
 // TX: not used in passthrough mode (polling TX used instead).
@@ -309,6 +372,9 @@ __interrupt void eUSCI_A1_ISR(void){
     case 0: break;                        // No interrupt
 
     case 2:{                              // RX -- character received from PC
+      if(UCA1STATW & UCOE){
+        Stats_Inc(STAT_UCA1_OVERRUN);
+      }
       usb_value = UCA1RXBUF;
 
       // First character from PC unlocks bidirectional TX
@@ -317,16 +383,18 @@ __interrupt void eUSCI_A1_ISR(void){
       }
 
       // Store in USB ring buffer (bookkeeping, not required for passthrough)
-      USB_Ring_Rx[usb_rx_wr++] = usb_value;
-      if(usb_rx_wr >= USB_RING_SIZE){
-        usb_rx_wr = BEGINNING;
-      }
+      USB_Ring_Rx[usb_rx_wr] = usb_value;
+      usb_rx_wr = (usb_rx_wr + 1) & USB_RING_MASK;
 
       //----------------------------------------------------------------------
       // FRAM command detection: '^' prefix.
       // ^^ -> FRAM responds "I'm here"
       // ^F -> switch UCA0 to 115,200 baud
       // ^S -> switch UCA0 to   9,600 baud
+      // ^L -> main-loop cycle report (loopstat.h)
+      // ^M -> stack high-water mark and headroom (stackmon.h)
+      // ^T -> event trace dump (trace.h)
+      // ^? -> STATS counter line; ^! also zeroes the counters (stats.h)
       // These bytes are consumed by the FRAM and NOT forwarded to the ESP32.
       //
       // Order matters: dispatch FIRST when already collecting, so that the
@@ -357,6 +425,21 @@ __interrupt void eUSCI_A1_ISR(void){
             Update_Baud_Display();
             USB_transmit_string("\r\nUCA0: 9,600\r\n");
             break;
+          case FRAM_CMD_LOOP:
+            Loop_Stats_Request();         // Printed from the main loop
+            break;
+          case FRAM_CMD_MEM:
+            Stack_Request();              // Answered by Stack_Check
+            break;
+          case FRAM_CMD_TRACE:
+            Trace_Dump_Request();         // Sent from the main loop
+            break;
+          case FRAM_CMD_STATS:
+            Stats_Request(STATS_REPORT);  // Sent from the main loop
+            break;
+          case FRAM_CMD_STATS_CLR:
+            Stats_Request(STATS_REPORT_RESET);
+            break;
           default:
             // Unknown ^ command -- ignore, do NOT forward to ESP32
             break;
@@ -24,8 +24,10 @@
 //==============================================================================
 // IOT ring buffer (UCA0 receive path -- ESP32 -> FRAM)
 //==============================================================================
-extern volatile char         IOT_Ring_Rx[IOT_RING_SIZE];
-extern volatile unsigned int iot_rx_wr;
+extern volatile char          IOT_Ring_Rx[IOT_RING_SIZE];
+extern volatile unsigned int  iot_rx_wr;
+extern volatile unsigned int  iot_rx_rd;
+extern volatile unsigned char iot_rx_overflow;  // Ring was full, not yet reported
 
 //==============================================================================
 // USB ring buffer (UCA1 receive path -- PC -> FRAM)
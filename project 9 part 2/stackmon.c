@@ -0,0 +1,129 @@
+//==============================================================================
+// File:        stackmon.c
+// Description: Stack painting and high-water mark -- see stackmon.h.
+//
+//              The stack grows down from __STACK_END, so painted words are
+//              at the bottom of the section and the high-water mark is the
+//              first word above them that was written.  The scan walks up
+//              from the bottom, i.e. only over the headroom that is left
+//              (at most a few dozen words, once per 200 ms).
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "msp430.h"
+#include "functions.h"
+#include "macros.h"
+#include "ports.h"
+#include "serial.h"
+#include "fmt.h"
+#include "stackmon.h"
+
+// Linker-defined (TI ELF): end of .stack and its size as an address
+extern unsigned int __STACK_END;
+extern unsigned int __STACK_SIZE;
+
+#define STACK_TOP       (&__STACK_END)
+#define STACK_BYTES     ((unsigned int)&__STACK_SIZE)
+#define STACK_BOTTOM    ((unsigned int *)((char *)STACK_TOP - STACK_BYTES))
+
+extern volatile unsigned int Time_Sequence;
+
+static unsigned int           stack_tick;
+static unsigned char          stack_warned   = FALSE;
+static volatile unsigned char stack_report   = FALSE;
+static char                   stack_buf[64];
+
+//==============================================================================
+// Function: Stack_Paint
+// Description: Fills the stack from its bottom to a few words below the
+//              current SP with STACK_PAINT.  Called with interrupts still
+//              disabled, before anything deep has run.
+//==============================================================================
+void Stack_Paint(void){
+    unsigned int *p   = STACK_BOTTOM;
+    unsigned int *end = (unsigned int *)__get_SP_register() - STACK_PAINT_GUARD;
+
+    while(p < end){
+        *p++ = STACK_PAINT;
+    }
+    stack_tick = Time_Sequence;
+}
+
+unsigned int Stack_Size(void){
+    return STACK_BYTES;
+}
+
+//==============================================================================
+// Function: Stack_High_Water
+// Description: Bytes between __STACK_END and the lowest non-paint word.
+//              Scanning up from the bottom means a local that was never
+//              written (still paint) cannot hide a deeper frame below it.
+//==============================================================================
+unsigned int Stack_High_Water(void){
+    unsigned int *p = STACK_BOTTOM;
+
+    while(p < STACK_TOP && *p == STACK_PAINT){
+        p++;
+    }
+    return (unsigned int)((char *)STACK_TOP - (char *)p);
+}
+
+//------------------------------------------------------------------------------
+// stack_put -- copy text, then bytes in decimal; returns the end
+//------------------------------------------------------------------------------
+static char *stack_put(char *p, const char *text, unsigned int bytes){
+    while(*text != SERIAL_NULL){
+        *p++ = *text++;
+    }
+    return Fmt_Dec(p, bytes, 0, FMT_SPACE);
+}
+
+//==============================================================================
+// Function: Stack_Check
+// Description: Main loop.  Every 200 ms tick: update the high-water mark
+//              and warn once if headroom is low or the bottom word is gone.
+//              Answers a pending ^M.
+//==============================================================================
+void Stack_Check(void){
+    unsigned int  hwm;
+    unsigned int  sp;
+    char         *p;
+
+    if(Time_Sequence == stack_tick && !stack_report){
+        return;
+    }
+    stack_tick = Time_Sequence;
+    hwm = Stack_High_Water();
+
+    if(!stack_warned && (*STACK_BOTTOM != STACK_PAINT
+                         || STACK_BYTES - hwm < STACK_WARN_BYTES)){
+        stack_warned = TRUE;
+        USB_transmit_string(*STACK_BOTTOM != STACK_PAINT
+                            ? "\r\nSTACK OVERFLOW\r\n" : "\r\nSTACK LOW\r\n");
+    }
+
+    if(stack_report){
+        stack_report = FALSE;
+        sp = __get_SP_register();
+        p  = stack_put(stack_buf, "\r\nStack ", STACK_BYTES);
+        p  = stack_put(p, " now ", (unsigned int)((char *)STACK_TOP - (char *)sp));
+        p  = stack_put(p, " hwm ", hwm);
+        p  = stack_put(p, " free ", STACK_BYTES - hwm);
+        *p++ = SERIAL_CR;
+        *p++ = SERIAL_LF;
+        *p   = SERIAL_NULL;
+        USB_transmit_string(stack_buf);
+    }
+}
+
+//==============================================================================
+// Function: Stack_Request
+// Description: ^M -- answered by the next Stack_Check.
+//==============================================================================
+void Stack_Request(void){
+    stack_report = TRUE;
+}
@@ -0,0 +1,37 @@
+//==============================================================================
+// File:        stackmon.h
+// Description: Stack high-water mark and headroom (Project 9 Part 2).
+//
+//              The .stack section sits at the top of the 4 KB RAM
+//              (lnk_msp430fr2355.cmd, RAM (HIGH)); its size is the project's
+//              --stack_size.  Stack_Paint fills the unused part with
+//              STACK_PAINT at boot.  Stack_Check runs from the main loop once
+//              per 200 ms tick: it finds the deepest word that is no longer
+//              paint (covers every ISR, nested or busy-waiting, since boot)
+//              and warns once on the PC backchannel when headroom drops
+//              below STACK_WARN_BYTES or the bottom word is gone (overflow).
+//
+//              ^M prints the stack size, current depth, high-water mark and
+//              headroom.  Static RAM per module comes from the linker map:
+//              host/rammap (see host/rammap.c).
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef STACKMON_H_
+#define STACKMON_H_
+
+#define STACK_PAINT         (0xA5A5u)
+#define STACK_PAINT_GUARD   (8)     // Words left unpainted below SP at boot
+#define STACK_WARN_BYTES    (32)
+
+void         Stack_Paint(void);         // First thing in main, GIE off
+void         Stack_Check(void);         // Main loop
+void         Stack_Request(void);       // ^M, from the UCA1 ISR
+unsigned int Stack_Size(void);          // Bytes
+unsigned int Stack_High_Water(void);    // Deepest use since boot, bytes
+
+#endif /* STACKMON_H_ */
@@ -0,0 +1,100 @@
+//==============================================================================
+// File:        stats.c
+// Description: Runtime event counters -- see stats.h.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "msp430.h"
+#include "functions.h"
+#include "macros.h"
+#include "ports.h"
+#include "serial.h"
+#include "fmt.h"
+#include "stats.h"
+
+#define STATS_KEY(id, key)  key,
+static const char *const stats_key[STAT_COUNT] = { STATS_COUNTERS(STATS_KEY) };
+#undef STATS_KEY
+
+static volatile unsigned int  stats[STAT_COUNT];
+static volatile unsigned char stats_request = FALSE;
+static volatile unsigned char stats_how     = STATS_REPORT;
+static char                   stats_buf[STATS_LINE_LEN];
+
+//==============================================================================
+// Function: Stats_Inc
+// Description: Saturating increment.  Called from the UCAx ISRs and the main
+//              loop, so the read-modify-write runs with interrupts off.
+//==============================================================================
+void Stats_Inc(unsigned char id){
+    unsigned short state = __get_interrupt_state();
+
+    __disable_interrupt();
+    if(stats[id] != 0xFFFFu){
+        stats[id]++;
+    }
+    __set_interrupt_state(state);
+}
+
+//==============================================================================
+// Function: Stats_Format
+// Description: "STATS key=value ..." CR LF into dst (STATS_LINE_LEN bytes),
+//              NUL-terminated.  Returns the NUL, so the caller has the
+//              length for AT+CIPSEND.  The counters are copied (and for
+//              STATS_REPORT_RESET cleared) in one interrupts-off pass, so a
+//              count lands either in this report or in the next one.
+//==============================================================================
+char *Stats_Format(char *dst, unsigned char how){
+    unsigned int   snap[STAT_COUNT];
+    unsigned short state;
+    const char    *k;
+    char          *p = dst;
+    unsigned char  i;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    for(i = 0; i < STAT_COUNT; i++){
+        snap[i] = stats[i];
+        if(how == STATS_REPORT_RESET){
+            stats[i] = 0;
+        }
+    }
+    __set_interrupt_state(state);
+
+    *p++ = 'S'; *p++ = 'T'; *p++ = 'A'; *p++ = 'T'; *p++ = 'S';
+    for(i = 0; i < STAT_COUNT; i++){
+        *p++ = ' ';
+        for(k = stats_key[i]; *k != SERIAL_NULL; k++){
+            *p++ = *k;
+        }
+        *p++ = '=';
+        p = Fmt_Dec(p, snap[i], 0, FMT_SPACE);
+    }
+    *p++ = SERIAL_CR;
+    *p++ = SERIAL_LF;
+    *p   = SERIAL_NULL;
+    return p;
+}
+
+void Stats_Request(unsigned char how){
+    stats_how     = how;
+    stats_request = TRUE;
+}
+
+//==============================================================================
+// Function: Stats_Process
+// Description: Main loop.  Answers a pending ^? / ^! on the PC backchannel.
+//==============================================================================
+void Stats_Process(void){
+    if(!stats_request){
+        return;
+    }
+    stats_request = FALSE;
+    Stats_Format(stats_buf, stats_how);
+    USB_transmit_string("\r\n");
+    USB_transmit_string(stats_buf);
+}
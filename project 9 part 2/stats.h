@@ -0,0 +1,62 @@
+//==============================================================================
+// File:        stats.h
+// Description: Runtime event counters (Project 9 Part 2).
+//
+//              One table of 16-bit counters for the things that go wrong (or
+//              right) while the car runs: UART overruns and RX ring
+//              overflows, command parse errors, commands executed, lost
+//              line, TCP / Wi-Fi events.  They live in RAM and start from
+//              zero at reset.  A counter stops at 65535: a reading of 65535
+//              means "at least", until ^!, ^1234?0001 or a reset clears it.
+//              The UCAx ISRs and the main loop both count, so Stats_Inc
+//              and the report's copy / clear run with interrupts off.
+//
+//              Both links answer with the same single line:
+//                STATS uo0=0 uo1=0 pin=0 time=0 qful=0 perr=0 cmd=0 ...
+//              PC backchannel:  ^?  report          ^!  report, then reset
+//              TCP:             ^1234?0000 report   ^1234?0001 report, reset
+//              The TCP reply goes back to the +IPD link it came from through
+//              AT+CIPSEND (iot.c).  Report-and-reset copies and clears in
+//              one interrupts-off pass, so a poller using it sees each
+//              event once -- unless a counter saturated in between.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef STATS_H_
+#define STATS_H_
+
+//------------------------------------------------------------------------------
+// Counters: X(id, key in the STATS line)
+//------------------------------------------------------------------------------
+#define STATS_COUNTERS(X)                                                     \
+    X(STAT_UCA0_OVERRUN,    "uo0")    /* UCOE on the ESP32 port            */ \
+    X(STAT_UCA1_OVERRUN,    "uo1")    /* UCOE on the PC backchannel        */ \
+    X(STAT_IOT_RX_OVERFLOW, "rxof")   /* IOT_Ring_Rx full, bytes dropped   */ \
+    X(STAT_ERR_PIN,         "pin")    /* ERR: bad PIN                      */ \
+    X(STAT_ERR_TIME,        "time")   /* ERR: bad time                     */ \
+    X(STAT_ERR_QUEUE,       "qful")   /* ERR: queue full                   */ \
+    X(STAT_ERR_OTHER,       "perr")   /* no ':', no cmd, bad dir / profile */ \
+    X(STAT_CMDS,            "cmd")    /* Commands executed                 */ \
+    X(STAT_LINE_LOST,       "lost")   /* Line lost during line-follow      */ \
+    X(STAT_TCP_CONNECT,     "conn")   /* TCP client connected              */ \
+    X(STAT_WIFI_DROP,       "wdis")   /* WIFI DISCONNECT from the ESP32    */
+
+#define STATS_ID(id, key)   id,
+enum { STATS_COUNTERS(STATS_ID) STAT_COUNT };
+#undef STATS_ID
+
+#define STATS_LINE_LEN      (128)   // Longest STATS line + CR LF + NUL
+
+#define STATS_REPORT        (0)     // Stats_Request / ^1234?000n argument
+#define STATS_REPORT_RESET  (1)
+
+void  Stats_Inc(unsigned char id);      // Saturating; ISR or main loop
+char *Stats_Format(char *dst, unsigned char how); // Returns the NUL
+void  Stats_Request(unsigned char how); // ^? / ^!, from the UCA1 ISR
+void  Stats_Process(void);              // Main loop; answers ^? / ^!
+
+#endif /* STATS_H_ */
@@ -6,7 +6,9 @@
 //                CCR1 -- SW1 interrupt-driven debounce
 //                CCR2 -- SW2 interrupt-driven debounce
 //
-//              No Timer B3 (no motor PWM needed in Project 8).
+//              Timer B1 (up mode) is the line-follow control clock,
+//              Timer B2 is a free-running cycle counter (loopstat.c) and
+//              Timer B3 drives the motor PWM.
 //
 //              Clock math (SMCLK = 8 MHz, ID__8, TBIDEX__8):
 //                Effective clock = 8,000,000 / 8 / 8 = 125,000 Hz
@@ -28,22 +30,62 @@
 //==============================================================================
 volatile unsigned int Time_Sequence = RESET_STATE;
 volatile char         one_time      = FALSE;
+volatile unsigned int cycle_hi      = RESET_STATE;  // TB2 overflows
 
 //==============================================================================
 // Function: Init_Timers
 //==============================================================================
 void Init_Timers(void){
     Init_Timer_B0();
+    Init_Timer_B1();    // Fixed-rate ADC sweep / control clock
+    Init_Timer_B2();    // Cycle counter for main-loop accounting
     Init_Timer_B3();    // Hardware PWM for motor control
 }
 
+//==============================================================================
+// Function: Init_Timer_B1
+// Description: Up mode at SMCLK/8 = 1 MHz; CCR0 fires every 1 / LF_CTRL_HZ
+//              and starts an ADC sweep (Timer1_B0_ISR).  Runs all the time so
+//              calibration and the thumbwheel see the same sample rate.
+//==============================================================================
+void Init_Timer_B1(void){
+    TB1CTL  = TBSSEL__SMCLK;          // Clock source = SMCLK (8 MHz)
+    TB1CTL |= MC__UP;                 // Up mode: count 0 -> TB1CCR0
+    TB1CTL |= ID__8;                  // Input divider: /8 -> 1 MHz
+    TB1CTL |= TBCLR;
+
+    TB1CCR0   = TB1CCR0_INTERVAL;
+    TB1CCTL0 &= ~CCIFG;
+    TB1CCTL0 |=  CCIE;
+}
+
+//==============================================================================
+// Function: Init_Timer_B2
+// Description: Continuous mode at SMCLK/1, so TB2R counts CPU cycles.  The
+//              overflow interrupt (every 8.2 ms) carries into cycle_hi;
+//              Cycles_Now (loopstat.c) joins the two.
+//==============================================================================
+void Init_Timer_B2(void){
+    TB2CTL  = TBSSEL__SMCLK;          // Clock source = SMCLK (8 MHz), no divider
+    TB2CTL |= MC__CONTINUOUS;         // Continuous mode: counts 0 -> 0xFFFF
+    TB2CTL |= TBCLR;
+
+    TB2CTL &= ~TBIFG;
+    TB2CTL |=  TBIE;                  // Overflow -> TIMER2_B1_ISR
+}
+
 //==============================================================================
 // Function: Init_Timer_B3
-// Description: Configures Timer B3 for hardware PWM on motor pins (P6.1-P6.4).
-//              Up mode: counts from 0 to TB3CCR0 = WHEEL_PERIOD_VAL.
-//              All four motor channels use output mode 7 (reset/set):
+// Description: Configures Timer B3 for hardware PWM on motor pins (P6.1-P6.5).
+//              Up mode: counts from 0 to TB3CCR0 = WHEEL_PERIOD_VAL, i.e.
+//              MOTOR_PWM_HZ (macros.h).
+//              All motor channels use output mode 7 (reset/set):
 //                pin HIGH at period start, LOW when CCR count reached.
 //              Setting a CCR to WHEEL_OFF (0) keeps the output LOW.
+//              CLLD_1 latches CCR writes at TB3R = 0, so the legs of a wheel
+//              always change together on a period boundary, where every
+//              driven leg rises; motor.c keeps each duty MOTOR_DEAD_COUNTS
+//              short of the period, which is the H-bridge dead time.
 //==============================================================================
 void Init_Timer_B3(void){
     TB3CTL  = TBSSEL__SMCLK;          // Clock source = SMCLK (8 MHz), no divider
@@ -60,16 +102,16 @@ void Init_Timer_B3(void){
     TB3CCTL1 = OUTMOD_7;
     TB3CCR1  = WHEEL_OFF;
 
-    TB3CCTL2 = OUTMOD_7;              // CCR2 -> P6.2 LEFT_FORWARD
+    TB3CCTL2 = OUTMOD_7 | CLLD_1;     // CCR2 -> P6.2 LEFT_FORWARD
     LEFT_FORWARD_SPEED  = WHEEL_OFF;
 
-    TB3CCTL3 = OUTMOD_7;              // CCR3 -> P6.3 RIGHT_FORWARD
+    TB3CCTL3 = OUTMOD_7 | CLLD_1;     // CCR3 -> P6.3 RIGHT_FORWARD
     RIGHT_FORWARD_SPEED = WHEEL_OFF;
 
-    TB3CCTL4 = OUTMOD_7;              // CCR4 -> P6.4 LEFT_REVERSE
+    TB3CCTL4 = OUTMOD_7 | CLLD_1;     // CCR4 -> P6.4 LEFT_REVERSE
     LEFT_REVERSE_SPEED  = WHEEL_OFF;
 
-    TB3CCTL5 = OUTMOD_7;              // CCR5 -> P6.5 RIGHT_REVERSE
+    TB3CCTL5 = OUTMOD_7 | CLLD_1;     // CCR5 -> P6.5 RIGHT_REVERSE
     RIGHT_REVERSE_SPEED = WHEEL_OFF;
 }
 
@@ -0,0 +1,164 @@
+//==============================================================================
+// File:        trace.c
+// Description: Binary event trace -- see trace.h.
+//
+//              Writing an event: interrupts off, timestamp, FRAM write
+//              protection lifted for the 8-byte store, restored, interrupts
+//              back to what they were.  The timestamp is taken with
+//              interrupts off, so a pending TB2 overflow is added from TBIFG
+//              rather than waiting for TIMER2_B1_ISR.
+//
+//              The dump is sent TRACE_DUMP_PER_PASS lines per main-loop pass
+//              (polled UART, ~2 ms per line at 115,200).  Events that arrive
+//              while it runs are dropped and counted, so the ring cannot
+//              move under the dump.
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#include "msp430.h"
+#include "functions.h"
+#include "macros.h"
+#include "ports.h"
+#include "serial.h"
+#include "fmt.h"
+#include "loopstat.h"
+#include "trace.h"
+
+#define TRACE_DUMP_PER_PASS (4)
+#define TRACE_LINE_LEN      (40)
+
+// FRAM: survives reset.  PERSISTENT needs an initializer; it is applied
+// only when the image is loaded, never at boot.
+#pragma PERSISTENT(trace_ring)
+static trace_event_t trace_ring[TRACE_DEPTH] = {{0}};
+#pragma PERSISTENT(trace_head)
+static unsigned int  trace_head = 0;        // Next slot; stays >= DEPTH once full
+
+static volatile unsigned char trace_frozen  = FALSE;
+static volatile unsigned int  trace_dropped = 0;
+static volatile unsigned char dump_request  = FALSE;
+static unsigned int           dump_next;    // Next event index to send
+static unsigned int           dump_left;    // Events still to send
+static unsigned char          dump_active   = FALSE;
+static char                   dump_buf[TRACE_LINE_LEN];
+
+//==============================================================================
+// Function: Trace_Event
+// Description: Append one event.  Safe from ISRs and the main loop.
+//==============================================================================
+void Trace_Event(unsigned char id, unsigned char a, unsigned int b){
+    unsigned short state = __get_interrupt_state();
+    trace_event_t *e;
+    unsigned int   lo;
+    unsigned int   hi;
+
+    __disable_interrupt();
+    if(trace_frozen){
+        trace_dropped++;
+    } else {
+        lo = TB2R;
+        hi = cycle_hi;
+        if((TB2CTL & TBIFG) && lo < 0x8000u){
+            hi++;                           // Wrapped, ISR not yet run
+        }
+        e = &trace_ring[trace_head & TRACE_MASK];
+        SYSCFG0 = FRWPPW | DFWP;            // Program FRAM writable
+        e->t_lo = lo;
+        e->t_hi = hi;
+        e->id   = id;
+        e->a    = a;
+        e->b    = b;
+        if(++trace_head >= 2 * TRACE_DEPTH){
+            trace_head -= TRACE_DEPTH;
+        }
+        SYSCFG0 = FRWPPW | DFWP | PFWP;
+    }
+    __set_interrupt_state(state);
+}
+
+//==============================================================================
+// Function: Trace_Init
+// Description: Marks the boot in the (persistent) ring with the reset
+//              cause.  Needs Timer B2 running.
+//==============================================================================
+void Trace_Init(void){
+    TRACE(TR_BOOT, SYSRSTIV, 0);
+}
+
+void Trace_Dump_Request(void){
+    dump_request = TRUE;
+}
+
+//------------------------------------------------------------------------------
+// dump_line -- "tttttttt ii aa bbbb" for ring slot i
+//------------------------------------------------------------------------------
+static void dump_line(unsigned int i){
+    const trace_event_t *e = &trace_ring[i & TRACE_MASK];
+    char                *p = dump_buf;
+
+    p = Fmt_Hex(p, e->t_hi, 4);
+    p = Fmt_Hex(p, e->t_lo, 4);
+    *p++ = ' ';
+    p = Fmt_Hex(p, e->id, 2);
+    *p++ = ' ';
+    p = Fmt_Hex(p, e->a, 2);
+    *p++ = ' ';
+    p = Fmt_Hex(p, e->b, 4);
+    *p++ = SERIAL_CR;
+    *p++ = SERIAL_LF;
+    *p   = SERIAL_NULL;
+    USB_transmit_string(dump_buf);
+}
+
+//==============================================================================
+// Function: Trace_Dump_Process
+// Description: Main loop.  Starts a pending ^T dump (header line, ring
+//              frozen) and sends the next TRACE_DUMP_PER_PASS events.
+//==============================================================================
+void Trace_Dump_Process(void){
+    unsigned char n;
+    char         *p;
+
+    if(!dump_active){
+        if(!dump_request){
+            return;
+        }
+        dump_request  = FALSE;
+        trace_frozen  = TRUE;
+        trace_dropped = 0;
+        dump_active   = TRUE;
+        dump_left     = (trace_head < TRACE_DEPTH) ? trace_head : TRACE_DEPTH;
+        dump_next     = trace_head - dump_left;
+
+        p = Fmt_Dec(dump_buf, TRACE_DEPTH, 0, FMT_SPACE);
+        *p++ = ' ';
+        p = Fmt_Dec32(p, TRACE_HZ, 0, FMT_SPACE);
+        *p++ = ' ';
+        p = Fmt_Dec(p, dump_left, 0, FMT_SPACE);
+        *p++ = SERIAL_CR;
+        *p++ = SERIAL_LF;
+        *p   = SERIAL_NULL;
+        USB_transmit_string("\r\nTRACE ");
+        USB_transmit_string(dump_buf);
+        return;
+    }
+
+    for(n = 0; n < TRACE_DUMP_PER_PASS && dump_left > 0; n++){
+        dump_line(dump_next++);
+        dump_left--;
+    }
+    if(dump_left == 0){
+        p = Fmt_Dec(dump_buf, trace_dropped, 0, FMT_SPACE);
+        *p++ = SERIAL_CR;
+        *p++ = SERIAL_LF;
+        *p   = SERIAL_NULL;
+        USB_transmit_string("TRACE end ");
+        USB_transmit_string(dump_buf);
+        dump_active  = FALSE;
+        trace_frozen = FALSE;
+    }
+}
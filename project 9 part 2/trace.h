@@ -0,0 +1,84 @@
+//==============================================================================
+// File:        trace.h
+// Description: Binary event trace (Project 9 Part 2).
+//
+//              TRACE(id, a, b) stores one 8-byte event -- 32-bit cycle
+//              timestamp (Timer B2 + cycle_hi, see loopstat.h), event id and
+//              two arguments -- into a TRACE_DEPTH ring.  It is safe from
+//              ISRs and costs a few dozen cycles, so it can sit next to (or
+//              instead of) the USB_transmit_string("LINE detected") style
+//              messages without changing the timing being debugged.
+//
+//              The ring and its write counter are #pragma PERSISTENT (FRAM),
+//              so they survive a reset: after a crash or watchdog restart
+//              the events leading up to it are still there, followed by a
+//              TR_BOOT event carrying the reset cause.
+//
+//              ^T on the PC backchannel dumps the ring as hex text, oldest
+//              event first; host/tracedec turns a terminal capture of it
+//              into Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+//              Dump format:
+//                TRACE <depth> <cycles per second> <events that follow>
+//                tttttttt ii aa bbbb           one line per event (hex)
+//                TRACE end <events dropped while dumping>
+//
+// Author: Thomas Gilbert
+// Date: Mar 2026
+// Compiler: Code Composer Studio
+// Target: MSP430FR2355
+//==============================================================================
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#define TRACE_DEPTH         (64)    // Events; power of two
+#define TRACE_MASK          (TRACE_DEPTH - 1)
+#define TRACE_HZ            SMCLK_HZ        // Timestamp rate (macros.h)
+
+//------------------------------------------------------------------------------
+// Events: X(id, value, decoder name).  a / b as noted.
+//------------------------------------------------------------------------------
+#define TRACE_EVENTS(X)                                                       \
+    X(TR_BOOT,       0x01, "boot")        /* a = SYSRSTIV reset cause      */ \
+    X(TR_IOT_STATE,  0x02, "iot state")   /* a = IOT_STATE_*               */ \
+    X(TR_IPD,        0x03, "ipd")         /* b = commands accepted         */ \
+    X(TR_CMD_ERR,    0x04, "cmd error")   /* a = TR_ERR_*                  */ \
+    X(TR_CMD_START,  0x05, "cmd start")   /* a = dir, b = time units       */ \
+    X(TR_CMD_DONE,   0x06, "cmd done")    /* a = dir (Timer B0 ISR)        */ \
+    X(TR_QUIT,       0x07, "quit")                                            \
+    X(TR_CAL_STATE,  0x08, "cal state")   /* a = CAL_ST_*                  */ \
+    X(TR_LF_STATE,   0x09, "line state")  /* a = LF_*                      */ \
+    X(TR_LF_FOUND,   0x0A, "line found")  /* b = search time, ms           */ \
+    X(TR_LF_LOST,    0x0B, "line lost")   /* b = search periods            */ \
+    X(TR_LF_END,     0x0C, "line end")    /* b = missed control periods    */
+
+#define TRACE_ID(name, value, text)   name = value,
+enum { TRACE_EVENTS(TRACE_ID) TR_LAST };
+#undef TRACE_ID
+
+// TR_CMD_ERR codes (the "ERR: ..." messages in iot.c)
+#define TR_ERR_BAD_DIR      (1)
+#define TR_ERR_BAD_PIN      (2)
+#define TR_ERR_BAD_TIME     (3)
+#define TR_ERR_NO_COLON     (4)
+#define TR_ERR_QUEUE_FULL   (5)
+#define TR_ERR_NO_CMD       (6)
+#define TR_ERR_BAD_PROFILE  (7)
+
+typedef struct {
+    unsigned int  t_lo;             // Cycles, low word (TB2R)
+    unsigned int  t_hi;             // Cycles, high word (cycle_hi)
+    unsigned char id;
+    unsigned char a;
+    unsigned int  b;
+} trace_event_t;
+
+#define TRACE(id, a, b)     Trace_Event((id), (unsigned char)(a), (unsigned int)(b))
+
+void Trace_Init(void);              // After Init_Timers; logs TR_BOOT
+void Trace_Event(unsigned char id, unsigned char a, unsigned int b);
+void Trace_Dump_Request(void);      // ^T, from the UCA1 ISR
+void Trace_Dump_Process(void);      // Main loop
+
+#endif /* TRACE_H_ */